@@ -2,12 +2,33 @@
 
 // Auto-generated main header
 
+#include <venus/float16.hpp>
+#include <venus/kernels/cache_info.hpp>
+#include <venus/kernels/convert.hpp>
+#include <venus/kernels/epilogue.hpp>
+#include <venus/kernels/gemm.hpp>
+#include <venus/kernels/gemm_tuning.hpp>
+#include <venus/kernels/gemv.hpp>
+#include <venus/kernels/histogram.hpp>
+#include <venus/kernels/math.hpp>
+#include <venus/kernels/predicate.hpp>
+#include <venus/kernels/qgemm.hpp>
+#include <venus/kernels/reduce.hpp>
+#include <venus/kernels/scan.hpp>
+#include <venus/kernels/segment.hpp>
+#include <venus/kernels/select.hpp>
+#include <venus/kernels/small_matrix.hpp>
+#include <venus/kernels/softmax.hpp>
+#include <venus/kernels/spmm.hpp>
+#include <venus/kernels/unique.hpp>
 #include <venus/memory/allocators.hpp>
 #include <venus/memory/contiguous_memory.hpp>
 #include <venus/memory/device.hpp>
 #include <venus/memory/lower_access.hpp>
 #include <venus/nested_initializer_list.hpp>
 #include <venus/null_param.hpp>
+#include <venus/parallel/execution.hpp>
+#include <venus/parallel/thread_pool.hpp>
 #include <venus/policies/policy_concepts.hpp>
 #include <venus/policies/policy_container.hpp>
 #include <venus/policies/policy_macro_begin.hpp>
@@ -16,7 +37,9 @@
 #include <venus/sequential.hpp>
 #include <venus/str.hpp>
 #include <venus/tensor/eager.hpp>
+#include <venus/tensor/quantized.hpp>
 #include <venus/tensor/shape.hpp>
+#include <venus/tensor/sparse.hpp>
 #include <venus/tensor/tensor.hpp>
 #include <venus/tensor/tensor_iterator.hpp>
 #include <venus/traits.hpp>
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace venus {
+
+// IEEE 754 binary16: 1 sign, 5 exponent, 10 mantissa bits
+struct Binary16Format {
+  static constexpr auto fromFloat(float value) noexcept -> std::uint16_t {
+    const auto bits = std::bit_cast<std::uint32_t>(value);
+    const auto sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000U);
+    const auto abs = bits & 0x7FFFFFFFU;
+
+    // NaN (kept quiet) and infinity
+    if (abs >= 0x7F800000U) {
+      const auto nan = abs > 0x7F800000U ? 0x0200U | ((abs >> 13) & 0x03FFU)
+                                         : 0U;
+      return static_cast<std::uint16_t>(sign | 0x7C00U | nan);
+    }
+    // Rounds past the largest finite half (65504)
+    if (abs >= 0x477FF000U) {
+      return static_cast<std::uint16_t>(sign | 0x7C00U);
+    }
+    // Subnormal half (or zero): shift in the implicit bit, round to even
+    if (abs < 0x38800000U) {
+      if (abs < 0x33000000U) {
+        return sign;
+      }
+      const auto shift = 126U - (abs >> 23);
+      const auto mantissa = (abs & 0x007FFFFFU) | 0x00800000U;
+      auto half = mantissa >> shift;
+      const auto rest = mantissa & ((1U << shift) - 1U);
+      const auto halfway = 1U << (shift - 1U);
+      half += static_cast<std::uint32_t>(
+          rest > halfway || (rest == halfway && (half & 1U) != 0U));
+      return static_cast<std::uint16_t>(sign | half);
+    }
+    // Normal: rebias the exponent, round to even (a carry may bump it)
+    auto half = (abs - 0x38000000U) >> 13;
+    const auto rest = abs & 0x1FFFU;
+    half += static_cast<std::uint32_t>(
+        rest > 0x1000U || (rest == 0x1000U && (half & 1U) != 0U));
+    return static_cast<std::uint16_t>(sign | half);
+  }
+
+  static constexpr auto toFloat(std::uint16_t half) noexcept -> float {
+    const auto sign = static_cast<std::uint32_t>(half & 0x8000U) << 16;
+    const auto exponent = (half >> 10) & 0x1FU;
+    auto mantissa = static_cast<std::uint32_t>(half & 0x03FFU);
+
+    if (exponent == 0x1FU) {
+      return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13));
+    }
+    if (exponent == 0) {
+      if (mantissa == 0) {
+        return std::bit_cast<float>(sign);
+      }
+      // Subnormal half is a normal float: renormalize the mantissa
+      auto biased = 113U;
+      while ((mantissa & 0x0400U) == 0) {
+        mantissa <<= 1;
+        --biased;
+      }
+      mantissa &= 0x03FFU;
+      return std::bit_cast<float>(sign | (biased << 23) | (mantissa << 13));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112U) << 23) |
+                                (mantissa << 13));
+  }
+
+  static constexpr std::uint16_t lowest = 0xFBFF;
+  static constexpr std::uint16_t max = 0x7BFF;
+  static constexpr std::uint16_t min = 0x0400;
+  static constexpr std::uint16_t denorm_min = 0x0001;
+  static constexpr std::uint16_t epsilon = 0x1400;
+  static constexpr std::uint16_t infinity = 0x7C00;
+  static constexpr std::uint16_t quiet_nan = 0x7E00;
+  static constexpr int digits = 11;
+  static constexpr int min_exponent = -13;
+  static constexpr int max_exponent = 16;
+};
+
+// bfloat16: the upper half of a binary32 (8 exponent, 7 mantissa bits)
+struct BFloat16Format {
+  static constexpr auto fromFloat(float value) noexcept -> std::uint16_t {
+    auto bits = std::bit_cast<std::uint32_t>(value);
+    if ((bits & 0x7FFFFFFFU) > 0x7F800000U) {
+      return static_cast<std::uint16_t>((bits >> 16) | 0x0040U);
+    }
+    bits += 0x7FFFU + ((bits >> 16) & 1U);
+    return static_cast<std::uint16_t>(bits >> 16);
+  }
+
+  static constexpr auto toFloat(std::uint16_t half) noexcept -> float {
+    return std::bit_cast<float>(static_cast<std::uint32_t>(half) << 16);
+  }
+
+  static constexpr std::uint16_t lowest = 0xFF7F;
+  static constexpr std::uint16_t max = 0x7F7F;
+  static constexpr std::uint16_t min = 0x0080;
+  static constexpr std::uint16_t denorm_min = 0x0001;
+  static constexpr std::uint16_t epsilon = 0x3C00;
+  static constexpr std::uint16_t infinity = 0x7F80;
+  static constexpr std::uint16_t quiet_nan = 0x7FC0;
+  static constexpr int digits = 8;
+  static constexpr int min_exponent = -125;
+  static constexpr int max_exponent = 128;
+};
+
+// 16-bit storage type that computes in fp32. Conversions mirror the C++23
+// extended floating-point types: widening (and from integers) is implicit,
+// narrowing from float/double is explicit.
+template <typename Format> class HalfPrecision {
+public:
+  constexpr HalfPrecision() noexcept = default;
+
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  constexpr explicit(std::is_floating_point_v<T>)
+      HalfPrecision(T value) noexcept
+      : m_bits(Format::fromFloat(static_cast<float>(value))) {}
+
+  static constexpr auto fromBits(std::uint16_t bits) noexcept
+      -> HalfPrecision {
+    HalfPrecision value;
+    value.m_bits = bits;
+    return value;
+  }
+
+  [[nodiscard]] constexpr auto bits() const noexcept -> std::uint16_t {
+    return m_bits;
+  }
+
+  constexpr operator float() const noexcept { return Format::toFloat(m_bits); }
+
+  template <typename T>
+  constexpr auto operator+=(const T &other) noexcept -> HalfPrecision & {
+    return *this = HalfPrecision(static_cast<float>(*this) + other);
+  }
+
+  template <typename T>
+  constexpr auto operator-=(const T &other) noexcept -> HalfPrecision & {
+    return *this = HalfPrecision(static_cast<float>(*this) - other);
+  }
+
+  template <typename T>
+  constexpr auto operator*=(const T &other) noexcept -> HalfPrecision & {
+    return *this = HalfPrecision(static_cast<float>(*this) * other);
+  }
+
+  template <typename T>
+  constexpr auto operator/=(const T &other) noexcept -> HalfPrecision & {
+    return *this = HalfPrecision(static_cast<float>(*this) / other);
+  }
+
+  constexpr auto operator++() noexcept -> HalfPrecision & { return *this += 1; }
+  constexpr auto operator--() noexcept -> HalfPrecision & { return *this -= 1; }
+
+  constexpr auto operator++(int) noexcept -> HalfPrecision {
+    auto old = *this;
+    *this += 1;
+    return old;
+  }
+
+  constexpr auto operator--(int) noexcept -> HalfPrecision {
+    auto old = *this;
+    *this -= 1;
+    return old;
+  }
+
+  constexpr auto operator-() const noexcept -> HalfPrecision {
+    return fromBits(static_cast<std::uint16_t>(m_bits ^ 0x8000U));
+  }
+
+  constexpr auto operator+() const noexcept -> HalfPrecision { return *this; }
+
+private:
+  std::uint16_t m_bits{};
+};
+
+using float16 = HalfPrecision<Binary16Format>;
+using bfloat16 = HalfPrecision<BFloat16Format>;
+
+template <typename T> struct IsHalfPrecision : std::false_type {};
+
+template <typename Format>
+struct IsHalfPrecision<HalfPrecision<Format>> : std::true_type {};
+
+template <typename T>
+concept HalfFloat = IsHalfPrecision<std::remove_cvref_t<T>>::value;
+
+// Type that sums/products of T are accumulated in
+template <typename T>
+using accumulator_t = std::conditional_t<HalfFloat<T>, float, T>;
+
+#define REGISTER_HALF_OP(op)                                                   \
+  template <typename Format1, typename Format2>                                \
+  constexpr auto operator op(const HalfPrecision<Format1> &lhs,                \
+                             const HalfPrecision<Format2> &rhs) noexcept       \
+      -> std::common_type_t<HalfPrecision<Format1>, HalfPrecision<Format2>> {  \
+    using Result =                                                             \
+        std::common_type_t<HalfPrecision<Format1>, HalfPrecision<Format2>>;    \
+    return Result(static_cast<float>(lhs) op static_cast<float>(rhs));         \
+  }                                                                            \
+                                                                               \
+  template <typename Format, typename T>                                       \
+    requires std::is_arithmetic_v<T>                                           \
+  constexpr auto operator op(const HalfPrecision<Format> &lhs,                 \
+                             const T &rhs) noexcept                            \
+      -> std::common_type_t<HalfPrecision<Format>, T> {                        \
+    using Result = std::common_type_t<HalfPrecision<Format>, T>;               \
+    return static_cast<Result>(static_cast<float>(lhs) op rhs);                \
+  }                                                                            \
+                                                                               \
+  template <typename T, typename Format>                                       \
+    requires std::is_arithmetic_v<T>                                           \
+  constexpr auto operator op(const T &lhs,                                     \
+                             const HalfPrecision<Format> &rhs) noexcept        \
+      -> std::common_type_t<T, HalfPrecision<Format>> {                        \
+    using Result = std::common_type_t<T, HalfPrecision<Format>>;               \
+    return static_cast<Result>(lhs op static_cast<float>(rhs));                \
+  }
+
+REGISTER_HALF_OP(+)
+REGISTER_HALF_OP(-)
+REGISTER_HALF_OP(*)
+REGISTER_HALF_OP(/)
+
+#undef REGISTER_HALF_OP
+
+template <typename Format1, typename Format2>
+constexpr auto operator==(const HalfPrecision<Format1> &lhs,
+                          const HalfPrecision<Format2> &rhs) noexcept -> bool {
+  return static_cast<float>(lhs) == static_cast<float>(rhs);
+}
+
+template <typename Format, typename T>
+  requires std::is_arithmetic_v<T>
+constexpr auto operator==(const HalfPrecision<Format> &lhs,
+                          const T &rhs) noexcept -> bool {
+  return static_cast<float>(lhs) == rhs;
+}
+
+template <typename Format1, typename Format2>
+constexpr auto operator<=>(const HalfPrecision<Format1> &lhs,
+                           const HalfPrecision<Format2> &rhs) noexcept {
+  return static_cast<float>(lhs) <=> static_cast<float>(rhs);
+}
+
+template <typename Format, typename T>
+  requires std::is_arithmetic_v<T>
+constexpr auto operator<=>(const HalfPrecision<Format> &lhs,
+                           const T &rhs) noexcept {
+  return static_cast<float>(lhs) <=> rhs;
+}
+
+template <typename Format>
+auto operator<<(std::ostream &os, const HalfPrecision<Format> &value)
+    -> std::ostream & {
+  return os << static_cast<float>(value);
+}
+
+} // namespace venus
+
+// Mixing with integers keeps the 16-bit type, mixing with float/double widens
+template <typename Format, typename T>
+  requires std::is_arithmetic_v<T>
+struct std::common_type<venus::HalfPrecision<Format>, T> {
+  using type = std::conditional_t<std::is_floating_point_v<T>, T,
+                                  venus::HalfPrecision<Format>>;
+};
+
+template <typename T, typename Format>
+  requires std::is_arithmetic_v<T>
+struct std::common_type<T, venus::HalfPrecision<Format>> {
+  using type = std::common_type_t<venus::HalfPrecision<Format>, T>;
+};
+
+template <>
+struct std::common_type<venus::float16, venus::bfloat16> {
+  using type = float;
+};
+
+template <>
+struct std::common_type<venus::bfloat16, venus::float16> {
+  using type = float;
+};
+
+template <typename Format>
+class std::numeric_limits<venus::HalfPrecision<Format>> {
+  using Half = venus::HalfPrecision<Format>;
+
+public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed = true;
+  static constexpr bool is_integer = false;
+  static constexpr bool is_exact = false;
+  static constexpr bool has_infinity = true;
+  static constexpr bool has_quiet_NaN = true;
+  static constexpr bool has_signaling_NaN = false;
+  static constexpr bool is_iec559 = false;
+  static constexpr bool is_bounded = true;
+  static constexpr bool is_modulo = false;
+  static constexpr int digits = Format::digits;
+  static constexpr int radix = 2;
+  static constexpr int min_exponent = Format::min_exponent;
+  static constexpr int max_exponent = Format::max_exponent;
+  static constexpr std::float_round_style round_style = std::round_to_nearest;
+
+  static constexpr auto min() noexcept { return Half::fromBits(Format::min); }
+  static constexpr auto max() noexcept { return Half::fromBits(Format::max); }
+  static constexpr auto lowest() noexcept {
+    return Half::fromBits(Format::lowest);
+  }
+  static constexpr auto epsilon() noexcept {
+    return Half::fromBits(Format::epsilon);
+  }
+  static constexpr auto round_error() noexcept { return Half(0.5F); }
+  static constexpr auto infinity() noexcept {
+    return Half::fromBits(Format::infinity);
+  }
+  static constexpr auto quiet_NaN() noexcept {
+    return Half::fromBits(Format::quiet_nan);
+  }
+  static constexpr auto denorm_min() noexcept {
+    return Half::fromBits(Format::denorm_min);
+  }
+};
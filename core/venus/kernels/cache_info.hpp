@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+namespace venus::kernels {
+
+// Data cache sizes of one core, in bytes. l3 is the share of the last level
+// cache per core that shares it.
+struct CacheSizes {
+  std::size_t l1d = std::size_t{32} << 10;
+  std::size_t l2 = std::size_t{256} << 10;
+  std::size_t l3 = std::size_t{2} << 20;
+
+  auto operator==(const CacheSizes &) const -> bool = default;
+};
+
+namespace detail {
+
+// "48K", "2048K", "32M" as in sysfs, 0 when unreadable
+inline auto parse_cache_size(const std::string &text) -> std::size_t {
+  std::size_t value = 0;
+  std::size_t i = 0;
+  for (; i < text.size() and text[i] >= '0' and text[i] <= '9'; ++i) {
+    value = (value * 10) + static_cast<std::size_t>(text[i] - '0');
+  }
+  if (i < text.size()) {
+    switch (text[i]) {
+    case 'K':
+      return value << 10;
+    case 'M':
+      return value << 20;
+    case 'G':
+      return value << 30;
+    default:
+      break;
+    }
+  }
+  return value;
+}
+
+// CPUs listed in a sysfs cpu list such as "0-3,8-11"
+inline auto count_cpu_list(const std::string &list) -> std::size_t {
+  std::size_t count = 0;
+  std::size_t pos = 0;
+  while (pos < list.size()) {
+    auto end = list.find(',', pos);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    const auto range = list.substr(pos, end - pos);
+    if (const auto dash = range.find('-'); dash != std::string::npos) {
+      count += std::stoul(range.substr(dash + 1)) -
+               std::stoul(range.substr(0, dash)) + 1;
+    } else if (not range.empty()) {
+      ++count;
+    }
+    pos = end + 1;
+  }
+  return std::max<std::size_t>(count, 1);
+}
+
+} // namespace detail
+
+// Cache sizes of the first CPU from sysfs, which Linux fills in on x86 and
+// Arm alike. Caches it does not report keep the defaults.
+inline auto detect_cache_sizes() -> CacheSizes {
+  auto caches = CacheSizes{};
+  for (int index = 0; index < 8; ++index) {
+    const auto dir = "/sys/devices/system/cpu/cpu0/cache/index" +
+                     std::to_string(index) + "/";
+    std::ifstream level_file(dir + "level");
+    std::ifstream type_file(dir + "type");
+    std::ifstream size_file(dir + "size");
+    int level = 0;
+    std::string type;
+    std::string size_text;
+    if (not(level_file >> level and type_file >> type and
+            size_file >> size_text)) {
+      continue;
+    }
+    const auto size = detail::parse_cache_size(size_text);
+    if (size == 0 or type == "Instruction") {
+      continue;
+    }
+
+    if (level == 1) {
+      caches.l1d = size;
+    } else if (level == 2) {
+      caches.l2 = size;
+    } else if (level == 3) {
+      std::ifstream shared_file(dir + "shared_cpu_list");
+      std::string shared;
+      try {
+        caches.l3 = shared_file >> shared
+                        ? size / detail::count_cpu_list(shared)
+                        : size;
+      } catch (const std::exception &) {
+        caches.l3 = size;
+      }
+    }
+  }
+  return caches;
+}
+
+// Cache sizes of this host, detected once
+inline auto cache_sizes() -> const CacheSizes & {
+  static const CacheSizes caches = detect_cache_sizes();
+  return caches;
+}
+
+} // namespace venus::kernels
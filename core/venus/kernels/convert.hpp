@@ -0,0 +1,76 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <venus/float16.hpp>
+
+#if defined(__F16C__) || defined(__AVX512BF16__) ||                          \
+    (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+namespace venus::kernels {
+
+// Elementwise dst[i] = To(src[i]), going through the accumulator type so
+// that half <-> bfloat16 (and half <-> integer) casts are well defined.
+template <typename From, typename To>
+void convert(const From *src, To *dst, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    dst[i] = static_cast<To>(static_cast<accumulator_t<From>>(src[i]));
+  }
+}
+
+inline void convert(const float16 *src, float *dst, std::size_t count) {
+  std::size_t i = 0;
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+  for (; i + 8 <= count; i += 8) {
+    const auto half =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(half));
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+inline void convert(const float *src, float16 *dst, std::size_t count) {
+  std::size_t i = 0;
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+  for (; i + 8 <= count; i += 8) {
+    const auto half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                      _MM_FROUND_TO_NEAREST_INT |
+                                          _MM_FROUND_NO_EXC);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), half);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = float16(src[i]);
+  }
+}
+
+// bfloat16 -> float is a 16-bit shift, which vectorizes as is
+inline void convert(const bfloat16 *src, float *dst, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    dst[i] = std::bit_cast<float>(static_cast<std::uint32_t>(src[i].bits())
+                                  << 16);
+  }
+}
+
+// The AVX512-BF16 path treats float denormals as zero, like the instruction
+inline void convert(const float *src, bfloat16 *dst, std::size_t count) {
+  std::size_t i = 0;
+#if defined(__AVX512BF16__)
+  for (; i + 16 <= count; i += 16) {
+    const auto packed = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        std::bit_cast<__m256i>(packed));
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = bfloat16(src[i]);
+  }
+}
+
+} // namespace venus::kernels
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <venus/kernels/math.hpp>
+
+namespace venus::kernels {
+
+enum class Activation { none, relu, gelu, silu };
+
+// Activation of one element in T. GELU is the tanh approximation
+// (0.5 x (1 + tanh(sqrt(2 / pi) (x + 0.044715 x^3)))), with tanh from exp so
+// that it vectorizes like SiLU. Integer types get GELU and SiLU computed in
+// double and rounded to the nearest integer.
+template <typename T> auto activate(Activation activation, T x) -> T {
+  if constexpr (not std::is_floating_point_v<T>) {
+    if (activation == Activation::gelu or activation == Activation::silu) {
+      return static_cast<T>(std::round(
+          activate<double>(activation, static_cast<double>(x))));
+    }
+  }
+  switch (activation) {
+  case Activation::none:
+    return x;
+  case Activation::relu:
+    return x > T{} ? x : T{};
+  case Activation::gelu: {
+    constexpr T sqrt_2_over_pi = static_cast<T>(0.7978845608028654);
+    constexpr T coeff = static_cast<T>(0.044715);
+    const T u = sqrt_2_over_pi * (x + (coeff * x * x * x));
+    const T tanh_u = T{1} - (T{2} / (exp_of<T>(T{2} * u) + T{1}));
+    return static_cast<T>(0.5) * x * (T{1} + tanh_u);
+  }
+  case Activation::silu:
+    return x / (T{1} + exp_of<T>(-x));
+  }
+  return x;
+}
+
+// Finishes rows of a product computed in T:
+// C = activation(scale * C + bias) + residual, with one bias per column and
+// a row-major residual the shape of C (leading dimension ldr). Missing bias
+// or residual are null. Applied by the GEMM to every register tile as soon
+// as its last k block is done, while it is still in L1, so the output is
+// written once instead of once per elementwise op.
+template <typename T, typename Bias = T, typename Residual = T>
+struct GemmEpilogue {
+  T scale = T{1};
+  const Bias *bias = nullptr;
+  const Residual *residual = nullptr;
+  std::size_t ldr = 0;
+  Activation activation = Activation::none;
+
+  // Row i, columns [j, j + n), at c
+  void operator()(std::size_t i, std::size_t j, T *c, std::size_t n) const {
+    if (scale != T{1}) {
+      for (std::size_t k = 0; k < n; ++k) {
+        c[k] *= scale;
+      }
+    }
+    if (bias != nullptr) {
+      for (std::size_t k = 0; k < n; ++k) {
+        c[k] += static_cast<T>(bias[j + k]);
+      }
+    }
+    // One loop per activation, so that each of them vectorizes
+    switch (activation) {
+    case Activation::none:
+      break;
+    case Activation::relu:
+      for (std::size_t k = 0; k < n; ++k) {
+        c[k] = activate(Activation::relu, c[k]);
+      }
+      break;
+    case Activation::gelu:
+      for (std::size_t k = 0; k < n; ++k) {
+        c[k] = activate(Activation::gelu, c[k]);
+      }
+      break;
+    case Activation::silu:
+      for (std::size_t k = 0; k < n; ++k) {
+        c[k] = activate(Activation::silu, c[k]);
+      }
+      break;
+    }
+    if (residual != nullptr) {
+      const auto *row = residual + (i * ldr) + j;
+      for (std::size_t k = 0; k < n; ++k) {
+        c[k] += static_cast<T>(row[k]);
+      }
+    }
+  }
+};
+
+} // namespace venus::kernels
@@ -0,0 +1,636 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <venus/kernels/cache_info.hpp>
+#include <venus/parallel/execution.hpp>
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__) ||         \
+    defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_neon.h>
+#endif
+
+namespace venus::kernels {
+
+// Read-only matrix with arbitrary strides, so that operands are packed
+// straight from wherever they live
+template <typename T> struct MatrixView {
+  const T *data;
+  std::size_t row_stride;
+  std::size_t col_stride;
+
+  constexpr auto operator()(std::size_t i, std::size_t j) const -> T {
+    return data[(i * row_stride) + (j * col_stride)];
+  }
+  // View whose element (0, 0) is this view's (i, j)
+  constexpr auto from(std::size_t i, std::size_t j) const -> MatrixView {
+    return {data + (i * row_stride) + (j * col_stride), row_stride,
+            col_stride};
+  }
+};
+
+namespace detail {
+
+// Register-level operations the micro-kernel needs: lanes of T per SIMD
+// register, and `rows` of A kept in flight so that rows x 2 accumulators
+// fill most of the register file. Types without a vector unit fall back to
+// plain loops over tiles of the same shape.
+template <typename T> struct SimdOps {
+  static constexpr bool enabled = false;
+#if defined(__AVX512F__)
+  static constexpr std::size_t lanes = std::max<std::size_t>(64 / sizeof(T), 1);
+#elif defined(__AVX__)
+  static constexpr std::size_t lanes = std::max<std::size_t>(32 / sizeof(T), 1);
+#else
+  static constexpr std::size_t lanes = std::max<std::size_t>(16 / sizeof(T), 1);
+#endif
+  static constexpr std::size_t rows = 4;
+};
+
+#if defined(__AVX512F__)
+inline constexpr const char *simd_isa = "avx512";
+
+template <> struct SimdOps<float> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 16;
+  static constexpr std::size_t rows = 12;
+  using type = __m512;
+
+  static auto zero() -> type { return _mm512_setzero_ps(); }
+  static auto broadcast(float x) -> type { return _mm512_set1_ps(x); }
+  static auto load(const float *p) -> type { return _mm512_loadu_ps(p); }
+  static void store(float *p, type v) { _mm512_storeu_ps(p, v); }
+  static auto add(type a, type b) -> type { return _mm512_add_ps(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return _mm512_fmadd_ps(a, b, c);
+  }
+};
+
+template <> struct SimdOps<double> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 8;
+  static constexpr std::size_t rows = 12;
+  using type = __m512d;
+
+  static auto zero() -> type { return _mm512_setzero_pd(); }
+  static auto broadcast(double x) -> type { return _mm512_set1_pd(x); }
+  static auto load(const double *p) -> type { return _mm512_loadu_pd(p); }
+  static void store(double *p, type v) { _mm512_storeu_pd(p, v); }
+  static auto add(type a, type b) -> type { return _mm512_add_pd(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return _mm512_fmadd_pd(a, b, c);
+  }
+};
+
+template <> struct SimdOps<std::int32_t> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 16;
+  static constexpr std::size_t rows = 12;
+  using type = __m512i;
+
+  static auto zero() -> type { return _mm512_setzero_si512(); }
+  static auto broadcast(std::int32_t x) -> type { return _mm512_set1_epi32(x); }
+  static auto load(const std::int32_t *p) -> type {
+    return _mm512_loadu_si512(p);
+  }
+  static void store(std::int32_t *p, type v) { _mm512_storeu_si512(p, v); }
+  static auto add(type a, type b) -> type { return _mm512_add_epi32(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return _mm512_add_epi32(_mm512_mullo_epi32(a, b), c);
+  }
+};
+#elif defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+inline constexpr const char *simd_isa = "avx2";
+
+template <> struct SimdOps<float> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 8;
+  static constexpr std::size_t rows = 6;
+  using type = __m256;
+
+  static auto zero() -> type { return _mm256_setzero_ps(); }
+  static auto broadcast(float x) -> type { return _mm256_set1_ps(x); }
+  static auto load(const float *p) -> type { return _mm256_loadu_ps(p); }
+  static void store(float *p, type v) { _mm256_storeu_ps(p, v); }
+  static auto add(type a, type b) -> type { return _mm256_add_ps(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return _mm256_fmadd_ps(a, b, c);
+  }
+};
+
+template <> struct SimdOps<double> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 4;
+  static constexpr std::size_t rows = 6;
+  using type = __m256d;
+
+  static auto zero() -> type { return _mm256_setzero_pd(); }
+  static auto broadcast(double x) -> type { return _mm256_set1_pd(x); }
+  static auto load(const double *p) -> type { return _mm256_loadu_pd(p); }
+  static void store(double *p, type v) { _mm256_storeu_pd(p, v); }
+  static auto add(type a, type b) -> type { return _mm256_add_pd(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return _mm256_fmadd_pd(a, b, c);
+  }
+};
+
+template <> struct SimdOps<std::int32_t> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 8;
+  static constexpr std::size_t rows = 6;
+  using type = __m256i;
+
+  static auto zero() -> type { return _mm256_setzero_si256(); }
+  static auto broadcast(std::int32_t x) -> type { return _mm256_set1_epi32(x); }
+  static auto load(const std::int32_t *p) -> type {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void store(std::int32_t *p, type v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  static auto add(type a, type b) -> type { return _mm256_add_epi32(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c);
+  }
+};
+#elif defined(__SSE2__) || defined(_M_X64)
+inline constexpr const char *simd_isa = "sse2";
+
+// SSE2 has no fused multiply-add (nor a 32-bit integer multiply)
+template <> struct SimdOps<float> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 4;
+  static constexpr std::size_t rows = 6;
+  using type = __m128;
+
+  static auto zero() -> type { return _mm_setzero_ps(); }
+  static auto broadcast(float x) -> type { return _mm_set1_ps(x); }
+  static auto load(const float *p) -> type { return _mm_loadu_ps(p); }
+  static void store(float *p, type v) { _mm_storeu_ps(p, v); }
+  static auto add(type a, type b) -> type { return _mm_add_ps(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+  }
+};
+
+template <> struct SimdOps<double> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 2;
+  static constexpr std::size_t rows = 6;
+  using type = __m128d;
+
+  static auto zero() -> type { return _mm_setzero_pd(); }
+  static auto broadcast(double x) -> type { return _mm_set1_pd(x); }
+  static auto load(const double *p) -> type { return _mm_loadu_pd(p); }
+  static void store(double *p, type v) { _mm_storeu_pd(p, v); }
+  static auto add(type a, type b) -> type { return _mm_add_pd(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return _mm_add_pd(_mm_mul_pd(a, b), c);
+  }
+};
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+inline constexpr const char *simd_isa = "neon";
+
+template <> struct SimdOps<float> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 4;
+  static constexpr std::size_t rows = 8;
+  using type = float32x4_t;
+
+  static auto zero() -> type { return vdupq_n_f32(0.0f); }
+  static auto broadcast(float x) -> type { return vdupq_n_f32(x); }
+  static auto load(const float *p) -> type { return vld1q_f32(p); }
+  static void store(float *p, type v) { vst1q_f32(p, v); }
+  static auto add(type a, type b) -> type { return vaddq_f32(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return vfmaq_f32(c, a, b);
+  }
+};
+
+template <> struct SimdOps<double> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 2;
+  static constexpr std::size_t rows = 8;
+  using type = float64x2_t;
+
+  static auto zero() -> type { return vdupq_n_f64(0.0); }
+  static auto broadcast(double x) -> type { return vdupq_n_f64(x); }
+  static auto load(const double *p) -> type { return vld1q_f64(p); }
+  static void store(double *p, type v) { vst1q_f64(p, v); }
+  static auto add(type a, type b) -> type { return vaddq_f64(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return vfmaq_f64(c, a, b);
+  }
+};
+
+template <> struct SimdOps<std::int32_t> {
+  static constexpr bool enabled = true;
+  static constexpr std::size_t lanes = 4;
+  static constexpr std::size_t rows = 8;
+  using type = int32x4_t;
+
+  static auto zero() -> type { return vdupq_n_s32(0); }
+  static auto broadcast(std::int32_t x) -> type { return vdupq_n_s32(x); }
+  static auto load(const std::int32_t *p) -> type { return vld1q_s32(p); }
+  static void store(std::int32_t *p, type v) { vst1q_s32(p, v); }
+  static auto add(type a, type b) -> type { return vaddq_s32(a, b); }
+  static auto fma(type a, type b, type c) -> type {
+    return vmlaq_s32(c, a, b);
+  }
+};
+#else
+inline constexpr const char *simd_isa = "scalar";
+#endif
+
+// Calls fn(std::integral_constant<std::size_t, I>{}) for I in [0, N), fully
+// unrolled, so that register tiles indexed by I stay in registers
+template <std::size_t N, typename Fn> void unroll(Fn &&fn) {
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    (fn(std::integral_constant<std::size_t, I>{}), ...);
+  }(std::make_index_sequence<N>{});
+}
+
+} // namespace detail
+
+// Register tile of the micro-kernel: mr rows of A times nr columns of B
+template <typename T> struct GemmTile {
+  static constexpr std::size_t mr = detail::SimdOps<T>::rows;
+  static constexpr std::size_t nr = 2 * detail::SimdOps<T>::lanes;
+};
+
+// Cache blocking of a GEMM. A kc x nc panel of B is packed once and reused
+// by every row block (sized for a share of L3); an mc x kc block of A is
+// packed for each of them (sized for L2); the micro-kernel then streams one
+// kc x nr sliver of B through L1 per register tile.
+struct GemmBlocking {
+  std::size_t mc;
+  std::size_t kc;
+  std::size_t nc;
+};
+
+// Blocking derived from the cache sizes: the B sliver fills L1, the A block
+// L2 and the B panel the L3 share of a core, capped at eight times L2 since
+// shared caches are rarely all ours. gemm_tuning.hpp measures better ones.
+template <typename T>
+auto default_gemm_blocking(const CacheSizes &caches = cache_sizes())
+    -> GemmBlocking {
+  constexpr auto mr = GemmTile<T>::mr;
+  constexpr auto nr = GemmTile<T>::nr;
+  const auto panel = std::clamp(caches.l3, caches.l2, 8 * caches.l2);
+  const auto kc =
+      std::clamp<std::size_t>(caches.l1d / (nr * sizeof(T)), 64, 384);
+  const auto mc =
+      std::max<std::size_t>((caches.l2 / (kc * sizeof(T))) / mr * mr, mr);
+  const auto nc =
+      std::max<std::size_t>((panel / (kc * sizeof(T))) / nr * nr, nr);
+  return {mc, kc, nc};
+}
+
+// Copies rows [0, m) x columns [0, k) of A into slivers of mr rows, each
+// stored column by column, padding the last sliver with zeros
+template <std::size_t MR, typename T, typename TA>
+void pack_a(MatrixView<TA> a, std::size_t m, std::size_t k, T *out) {
+  for (std::size_t ir = 0; ir < m; ir += MR) {
+    const auto rows = std::min(MR, m - ir);
+    for (std::size_t p = 0; p < k; ++p) {
+      for (std::size_t i = 0; i < MR; ++i) {
+        *out++ = i < rows ? static_cast<T>(a(ir + i, p)) : T{};
+      }
+    }
+  }
+}
+
+// Copies rows [0, k) x columns [0, n) of B into slivers of nr columns, each
+// stored row by row, padding the last sliver with zeros
+template <std::size_t NR, typename T, typename TB>
+void pack_b(MatrixView<TB> b, std::size_t k, std::size_t n, T *out) {
+  for (std::size_t jr = 0; jr < n; jr += NR) {
+    const auto cols = std::min(NR, n - jr);
+    for (std::size_t p = 0; p < k; ++p) {
+      for (std::size_t j = 0; j < NR; ++j) {
+        *out++ = j < cols ? static_cast<T>(b(p, jr + j)) : T{};
+      }
+    }
+  }
+}
+
+// C[0:m, 0:n] (+)= A B for one register tile, from an mr-row sliver of
+// packed A and an nr-column sliver of packed B. `accumulate` adds to C
+// instead of overwriting it (for every k block after the first).
+template <typename T, std::size_t MR, std::size_t NR>
+void gemm_micro_kernel(std::size_t kc, const T *a, const T *b, T *c,
+                       std::size_t ldc, std::size_t m, std::size_t n,
+                       bool accumulate) {
+  using Ops = detail::SimdOps<T>;
+
+  if constexpr (Ops::enabled) {
+    constexpr auto L = Ops::lanes;
+    constexpr auto V = NR / L;
+    typename Ops::type acc[MR][V];
+    detail::unroll<MR>([&](auto i) {
+      detail::unroll<V>([&](auto v) { acc[i][v] = Ops::zero(); });
+    });
+
+    for (std::size_t p = 0; p < kc; ++p) {
+      typename Ops::type row[V];
+      detail::unroll<V>(
+          [&](auto v) { row[v] = Ops::load(b + (p * NR) + (v * L)); });
+      detail::unroll<MR>([&](auto i) {
+        const auto lhs = Ops::broadcast(a[(p * MR) + i]);
+        detail::unroll<V>(
+            [&](auto v) { acc[i][v] = Ops::fma(lhs, row[v], acc[i][v]); });
+      });
+    }
+
+    if (m == MR and n == NR) {
+      detail::unroll<MR>([&](auto i) {
+        detail::unroll<V>([&](auto v) {
+          auto *out = c + (i * ldc) + (v * L);
+          Ops::store(out, accumulate ? Ops::add(Ops::load(out), acc[i][v])
+                                     : acc[i][v]);
+        });
+      });
+      return;
+    }
+
+    // Edge tile: spill the registers and write the part that is in C
+    T tile[MR][NR];
+    detail::unroll<MR>([&](auto i) {
+      detail::unroll<V>(
+          [&](auto v) { Ops::store(tile[i] + (v * L), acc[i][v]); });
+    });
+    for (std::size_t i = 0; i < m; ++i) {
+      for (std::size_t j = 0; j < n; ++j) {
+        auto &out = c[(i * ldc) + j];
+        out = accumulate ? out + tile[i][j] : tile[i][j];
+      }
+    }
+  } else {
+    T tile[MR][NR] = {};
+    for (std::size_t p = 0; p < kc; ++p) {
+      for (std::size_t i = 0; i < MR; ++i) {
+        for (std::size_t j = 0; j < NR; ++j) {
+          tile[i][j] += a[(p * MR) + i] * b[(p * NR) + j];
+        }
+      }
+    }
+    for (std::size_t i = 0; i < m; ++i) {
+      for (std::size_t j = 0; j < n; ++j) {
+        auto &out = c[(i * ldc) + j];
+        out = accumulate ? out + tile[i][j] : tile[i][j];
+      }
+    }
+  }
+}
+
+// Multiply-adds below which splitting a GEMM across one more thread costs
+// more in wake-up and synchronization than it saves
+inline constexpr std::size_t gemm_min_work = std::size_t{1} << 20;
+
+// Epilogue that leaves C as the product. An epilogue is called as
+// epilogue(i, j, c, n) on row i, columns [j, j + n), of C, at c, once the
+// product there is complete.
+struct NoEpilogue {
+  template <typename T>
+  void operator()(std::size_t /*i*/, std::size_t /*j*/, T * /*c*/,
+                  std::size_t /*n*/) const {}
+};
+
+template <typename T, typename TA, typename TB, typename Policy,
+          typename Epilogue = NoEpilogue>
+void gemm(Policy &&policy, std::size_t M, std::size_t N, std::size_t K,
+          MatrixView<TA> a, MatrixView<TB> b, T *c, std::size_t ldc,
+          const GemmBlocking &blocking = default_gemm_blocking<T>(),
+          const Epilogue &epilogue = {});
+
+// GEMM with too few tiles of C to go around but a long K (skinny-wide
+// shapes): the k blocks are multiplied in parallel rounds, one per piece,
+// into private products that are then added to C in k order. The first
+// block writes C directly, so every sum associates exactly as in the
+// sequential loop.
+template <typename T, typename TA, typename TB, typename Policy>
+void gemm_split_k(Policy &&policy, std::size_t pieces, std::size_t M,
+                  std::size_t N, std::size_t K, MatrixView<TA> a,
+                  MatrixView<TB> b, T *c, std::size_t ldc,
+                  const GemmBlocking &blocking) {
+  const auto kc = std::min(blocking.kc, K);
+  const auto k_blocks = (K + kc - 1) / kc;
+  auto partials = std::make_unique<T[]>(pieces * M * N);
+
+  for (std::size_t round = 0; round < k_blocks; round += pieces) {
+    const auto count = std::min(pieces, k_blocks - round);
+    execution::for_each_chunk(
+        policy, count,
+        [&](std::size_t begin, std::size_t end) {
+          for (auto q = begin; q < end; ++q) {
+            const auto pc = (round + q) * kc;
+            const bool direct = round + q == 0;
+            gemm(execution::seq, M, N, std::min(kc, K - pc), a.from(0, pc),
+                 b.from(pc, 0), direct ? c : partials.get() + (q * M * N),
+                 direct ? ldc : N, blocking);
+          }
+        },
+        1);
+
+    execution::for_each_chunk(
+        policy, M,
+        [&](std::size_t row_begin, std::size_t row_end) {
+          for (auto i = row_begin; i < row_end; ++i) {
+            for (std::size_t q = round == 0 ? 1 : 0; q < count; ++q) {
+              const auto *partial = partials.get() + (q * M * N) + (i * N);
+              auto *row = c + (i * ldc);
+              for (std::size_t j = 0; j < N; ++j) {
+                row[j] += partial[j];
+              }
+            }
+          }
+        },
+        std::max<std::size_t>(execution::default_grain / (N * count), 1));
+  }
+}
+
+// C = A B with C (M x N) row major with leading dimension ldc, computed in
+// T: both operands are converted to T while they are packed. Loops over
+// panels of B, blocks of A, then register tiles, as in BLIS.
+//
+// Parallel policies use one piece per gemm_min_work multiply-adds, up to
+// the pool size. Every panel of B is packed once, its slivers split across
+// the pieces, and then shared by all of them; each piece packs its own
+// blocks of A and computes a contiguous run of (row block, column group)
+// tasks, column groups being used only when there are fewer row blocks than
+// pieces. Every element of C is summed in the same order whatever the
+// split, so the result does not depend on the policy or the thread count.
+//
+// The epilogue finishes every register tile right after its last k block
+// (after the merge when K is split).
+template <typename T, typename TA, typename TB, typename Policy,
+          typename Epilogue>
+void gemm(Policy &&policy, std::size_t M, std::size_t N, std::size_t K,
+          MatrixView<TA> a, MatrixView<TB> b, T *c, std::size_t ldc,
+          const GemmBlocking &blocking, const Epilogue &epilogue) {
+  constexpr auto MR = GemmTile<T>::mr;
+  constexpr auto NR = GemmTile<T>::nr;
+
+  if (M == 0 or N == 0) {
+    return;
+  }
+  if (K == 0) {
+    for (std::size_t i = 0; i < M; ++i) {
+      std::fill(c + (i * ldc), c + (i * ldc) + N, T{});
+      epilogue(i, 0, c + (i * ldc), N);
+    }
+    return;
+  }
+
+  const auto ceil_div = [](std::size_t x, std::size_t by) {
+    return (x + by - 1) / by;
+  };
+  const auto pieces =
+      execution::partitions(policy, M * N * K, gemm_min_work);
+  const auto kc = std::min(blocking.kc, K);
+
+  if (pieces > 1 and ceil_div(M, MR) * ceil_div(N, NR) < pieces and K > kc) {
+    gemm_split_k(policy, pieces, M, N, K, a, b, c, ldc, blocking);
+    if constexpr (not std::is_same_v<Epilogue, NoEpilogue>) {
+      execution::for_each_chunk(
+          policy, M,
+          [&](std::size_t row_begin, std::size_t row_end) {
+            for (auto i = row_begin; i < row_end; ++i) {
+              epilogue(i, 0, c + (i * ldc), N);
+            }
+          },
+          std::max<std::size_t>(execution::default_grain / N, 1));
+    }
+    return;
+  }
+
+  // Row blocks no taller than an even share of the rows, so that all the
+  // pieces get some
+  const auto mc = std::min(ceil_div(std::min(blocking.mc, M), MR),
+                           ceil_div(ceil_div(M, pieces), MR)) *
+                  MR;
+  const auto nc = ceil_div(std::min(blocking.nc, N), NR) * NR;
+  const auto row_blocks = ceil_div(M, mc);
+  auto packed_a = std::make_unique<T[]>(pieces * mc * kc);
+  auto packed_b = std::make_unique<T[]>(nc * kc);
+
+  for (std::size_t jc = 0; jc < N; jc += nc) {
+    const auto nb = std::min(nc, N - jc);
+    const auto slivers = ceil_div(nb, NR);
+    const auto groups =
+        std::min(slivers, std::max<std::size_t>(pieces / row_blocks, 1));
+    const auto tasks = row_blocks * groups;
+
+    for (std::size_t pc = 0; pc < K; pc += kc) {
+      const auto kb = std::min(kc, K - pc);
+
+      execution::for_each_chunk(
+          policy, pieces,
+          [&](std::size_t piece_begin, std::size_t piece_end) {
+            for (auto piece = piece_begin; piece < piece_end; ++piece) {
+              const auto first = (piece * slivers) / pieces;
+              const auto last = ((piece + 1) * slivers) / pieces;
+              if (first < last) {
+                pack_b<NR>(b.from(pc, jc + (first * NR)), kb,
+                           std::min(nb, last * NR) - (first * NR),
+                           packed_b.get() + (first * NR * kb));
+              }
+            }
+          },
+          1);
+
+      execution::for_each_chunk(
+          policy, pieces,
+          [&](std::size_t piece_begin, std::size_t piece_end) {
+            for (auto piece = piece_begin; piece < piece_end; ++piece) {
+              auto *block = packed_a.get() + (piece * mc * kc);
+              auto packed_row_block = row_blocks;
+              const auto end = ((piece + 1) * tasks) / pieces;
+              for (auto task = (piece * tasks) / pieces; task < end; ++task) {
+                const auto ic = (task / groups) * mc;
+                const auto mb = std::min(mc, M - ic);
+                if (task / groups != packed_row_block) {
+                  pack_a<MR>(a.from(ic, pc), mb, kb, block);
+                  packed_row_block = task / groups;
+                }
+
+                const auto group = task % groups;
+                const auto first = ((group * slivers) / groups) * NR;
+                const auto last =
+                    std::min(nb, (((group + 1) * slivers) / groups) * NR);
+                for (auto jr = first; jr < last; jr += NR) {
+                  for (std::size_t ir = 0; ir < mb; ir += MR) {
+                    auto *tile = c + ((ic + ir) * ldc) + jc + jr;
+                    const auto m = std::min(MR, mb - ir);
+                    const auto n = std::min(NR, nb - jr);
+                    gemm_micro_kernel<T, MR, NR>(
+                        kb, block + (ir * kb), packed_b.get() + (jr * kb),
+                        tile, ldc, m, n, pc > 0);
+                    if (pc + kb == K) {
+                      for (std::size_t r = 0; r < m; ++r) {
+                        epilogue(ic + ir + r, jc + jr, tile + (r * ldc), n);
+                      }
+                    }
+                  }
+                }
+              }
+            }
+          },
+          1);
+    }
+  }
+}
+
+// A batch of C_i = A_i B_i, all M x N x K: operand i starts at the given
+// element offset from the view's origin, and C_i at c + i * c_stride.
+// Broadcast batches just repeat offsets.
+//
+// Batches and tiles are scheduled together. With at least as many matrices
+// as pieces, each piece multiplies a contiguous run of them on its own, so
+// that a large batch of small matrices keeps every thread busy without any
+// fork/join per matrix; with fewer, the matrices are multiplied one after
+// the other, each split across all the pieces. Either way every product is
+// the one gemm computes, whatever the policy or the thread count.
+template <typename T, typename TA, typename TB, typename Policy>
+void gemm_batched(Policy &&policy, std::size_t batch, std::size_t M,
+                  std::size_t N, std::size_t K, MatrixView<TA> a,
+                  const std::size_t *a_offsets, MatrixView<TB> b,
+                  const std::size_t *b_offsets, T *c, std::size_t ldc,
+                  std::size_t c_stride,
+                  const GemmBlocking &blocking = default_gemm_blocking<T>()) {
+  const auto at = [](auto view, std::size_t offset) {
+    view.data += offset;
+    return view;
+  };
+
+  const auto pieces =
+      execution::partitions(policy, batch * M * N * K, gemm_min_work);
+  if (batch < pieces) {
+    for (std::size_t i = 0; i < batch; ++i) {
+      gemm(policy, M, N, K, at(a, a_offsets[i]), at(b, b_offsets[i]),
+           c + (i * c_stride), ldc, blocking);
+    }
+    return;
+  }
+
+  execution::for_each_chunk(
+      policy, pieces,
+      [&](std::size_t piece_begin, std::size_t piece_end) {
+        for (auto piece = piece_begin; piece < piece_end; ++piece) {
+          const auto end = ((piece + 1) * batch) / pieces;
+          for (auto i = (piece * batch) / pieces; i < end; ++i) {
+            gemm(execution::seq, M, N, K, at(a, a_offsets[i]),
+                 at(b, b_offsets[i]), c + (i * c_stride), ldc, blocking);
+          }
+        }
+      },
+      1);
+}
+
+} // namespace venus::kernels
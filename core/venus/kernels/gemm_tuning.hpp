@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <venus/kernels/cache_info.hpp>
+#include <venus/kernels/gemm.hpp>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// Problem the tuner times every candidate blocking on, large enough along
+// every dimension for the candidates to differ
+struct GemmTuningProblem {
+  std::size_t m = 512;
+  std::size_t n = 2048;
+  std::size_t k = 1024;
+};
+
+namespace detail {
+
+template <typename T> constexpr auto gemm_type_name() -> std::string_view {
+  if constexpr (std::is_same_v<T, float>) {
+    return "float";
+  } else if constexpr (std::is_same_v<T, double>) {
+    return "double";
+  } else if constexpr (std::is_same_v<T, std::int32_t>) {
+    return "int32";
+  } else if constexpr (std::is_same_v<T, std::int64_t>) {
+    return "int64";
+  } else {
+    return "";
+  }
+}
+
+// Best of three runs after a warm-up, in seconds
+template <typename T>
+auto time_gemm(const GemmTuningProblem &problem, const T *a, const T *b, T *c,
+               const GemmBlocking &blocking) -> double {
+  const auto run = [&] {
+    gemm(execution::seq, problem.m, problem.n, problem.k,
+         MatrixView<T>{a, problem.k, 1}, MatrixView<T>{b, problem.n, 1}, c,
+         problem.n, blocking);
+  };
+  run();
+  auto best = std::chrono::duration<double>::max();
+  for (int i = 0; i < 3; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    best = std::min<std::chrono::duration<double>>(
+        best, std::chrono::steady_clock::now() - start);
+  }
+  return best.count();
+}
+
+// Blocking chosen for T in this process. The mutex serializes resolving
+// it (cache lookup, tuning) and replacing it; lookups once it is published
+// only read the pointer. Every published blocking is kept, so a reader of
+// an older one never sees it freed.
+template <typename T> struct TunedGemmBlocking {
+  static inline std::mutex mutex;
+  static inline std::atomic<const GemmBlocking *> current{nullptr};
+  static inline std::vector<std::unique_ptr<const GemmBlocking>> published;
+
+  // With the mutex held
+  static void publish(const GemmBlocking &blocking) {
+    published.push_back(std::make_unique<const GemmBlocking>(blocking));
+    current.store(published.back().get(), std::memory_order_release);
+  }
+};
+
+} // namespace detail
+
+// Times candidate block sizes for T on this core, one at a time (kc, then
+// mc, then nc, each around the best so far), and returns the fastest. The
+// register tile is fixed by the instruction set at compile time, so only
+// the cache blocking is searched. Takes seconds for the default problem.
+template <typename T>
+auto tune_gemm_blocking(const GemmTuningProblem &problem = {})
+    -> GemmBlocking {
+  constexpr auto mr = GemmTile<T>::mr;
+  constexpr auto nr = GemmTile<T>::nr;
+
+  auto a = std::make_unique<T[]>(problem.m * problem.k);
+  auto b = std::make_unique<T[]>(problem.k * problem.n);
+  auto c = std::make_unique<T[]>(problem.m * problem.n);
+  for (std::size_t i = 0; i < problem.m * problem.k; ++i) {
+    a[i] = static_cast<T>(i % 7);
+  }
+  for (std::size_t i = 0; i < problem.k * problem.n; ++i) {
+    b[i] = static_cast<T>(i % 5);
+  }
+
+  auto best = default_gemm_blocking<T>();
+  auto best_time =
+      detail::time_gemm(problem, a.get(), b.get(), c.get(), best);
+  const auto try_candidates = [&](std::size_t GemmBlocking::*field,
+                                  const std::vector<std::size_t> &values,
+                                  std::size_t limit) {
+    for (const auto value : values) {
+      auto candidate = best;
+      candidate.*field = value;
+      // Blocks past the problem size all time the same
+      if (value > limit or candidate.*field == best.*field) {
+        continue;
+      }
+      const auto time =
+          detail::time_gemm(problem, a.get(), b.get(), c.get(), candidate);
+      if (time < best_time) {
+        best = candidate;
+        best_time = time;
+      }
+    }
+  };
+
+  try_candidates(&GemmBlocking::kc, {64, 128, 192, 256, 320, 384, 512},
+                 problem.k);
+  try_candidates(&GemmBlocking::mc,
+                 {4 * mr, 8 * mr, 16 * mr, 24 * mr, 32 * mr, 48 * mr, 64 * mr},
+                 problem.m + mr - 1);
+  try_candidates(&GemmBlocking::nc,
+                 {16 * nr, 32 * nr, 64 * nr, 128 * nr, 256 * nr},
+                 problem.n + nr - 1);
+  return best;
+}
+
+// Tuning cache file: VENUS_GEMM_TUNING_CACHE, else venus/gemm_tuning.txt
+// under XDG_CACHE_HOME or ~/.cache; empty when there is nowhere to put it
+inline auto gemm_tuning_cache_path() -> std::filesystem::path {
+  if (const char *env = std::getenv("VENUS_GEMM_TUNING_CACHE")) {
+    return env;
+  }
+  if (const char *xdg = std::getenv("XDG_CACHE_HOME")) {
+    return std::filesystem::path(xdg) / "venus" / "gemm_tuning.txt";
+  }
+  if (const char *home = std::getenv("HOME")) {
+    return std::filesystem::path(home) / ".cache" / "venus" /
+           "gemm_tuning.txt";
+  }
+  return {};
+}
+
+// Key of a tuning result: the instruction set, the type and the caches, so
+// that one file can serve a fleet of different hosts
+template <typename T>
+auto gemm_tuning_key(const CacheSizes &caches = cache_sizes()) -> std::string {
+  return std::string(detail::simd_isa) + " " +
+         std::string(detail::gemm_type_name<T>()) + " " +
+         std::to_string(caches.l1d) + " " + std::to_string(caches.l2) + " " +
+         std::to_string(caches.l3);
+}
+
+// The blocking stored under `key`, if any. The file holds one line per key:
+// the key, then mc, kc and nc.
+inline auto load_gemm_blocking(const std::filesystem::path &path,
+                               const std::string &key)
+    -> std::optional<GemmBlocking> {
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.size() > key.size() and line.starts_with(key) and
+        line[key.size()] == ' ') {
+      auto values = std::istringstream(line.substr(key.size()));
+      GemmBlocking blocking{};
+      if (values >> blocking.mc >> blocking.kc >> blocking.nc and
+          blocking.mc > 0 and blocking.kc > 0 and blocking.nc > 0) {
+        return blocking;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+// Stores the blocking under `key`, replacing any previous entry. Written to
+// a temporary file of its own and renamed over the cache, so that readers
+// see a complete file, old or new. Two processes storing at once each
+// replace the file whole, so one of their entries can be lost (and is
+// tuned again later), but never mixed up. Returns false when it cannot be
+// written.
+inline auto store_gemm_blocking(const std::filesystem::path &path,
+                                const std::string &key,
+                                const GemmBlocking &blocking) -> bool {
+  std::error_code error;
+  if (path.has_parent_path()) {
+    std::filesystem::create_directories(path.parent_path(), error);
+  }
+
+  std::vector<std::string> lines;
+  {
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+      if (not(line.starts_with(key) and line.size() > key.size() and
+              line[key.size()] == ' ')) {
+        lines.push_back(line);
+      }
+    }
+  }
+  lines.push_back(key + " " + std::to_string(blocking.mc) + " " +
+                  std::to_string(blocking.kc) + " " +
+                  std::to_string(blocking.nc));
+
+  // In the same directory, so that the rename does not cross filesystems
+  auto random = std::random_device();
+  auto temporary = path;
+  temporary += ".tmp." + std::to_string(random()) + std::to_string(random());
+  {
+    std::ofstream file(temporary, std::ios::trunc);
+    for (const auto &line : lines) {
+      file << line << '\n';
+    }
+    if (not file.flush()) {
+      file.close();
+      std::filesystem::remove(temporary, error);
+      return false;
+    }
+  }
+  std::filesystem::rename(temporary, path, error);
+  if (error) {
+    std::error_code ignored;
+    std::filesystem::remove(temporary, ignored);
+    return false;
+  }
+  return true;
+}
+
+namespace detail {
+
+// Tunes T and stores the result in the tuning cache, if there is one
+template <typename T>
+auto tune_and_store_gemm(const GemmTuningProblem &problem) -> GemmBlocking {
+  const auto blocking = tune_gemm_blocking<T>(problem);
+  if (const auto path = gemm_tuning_cache_path(); not path.empty()) {
+    store_gemm_blocking(path, gemm_tuning_key<T>(), blocking);
+  }
+  return blocking;
+}
+
+} // namespace detail
+
+// Tunes T for this host, stores the result in the tuning cache and uses it
+// for the rest of the process
+template <typename T>
+auto autotune_gemm(const GemmTuningProblem &problem = {}) -> GemmBlocking {
+  using Tuned = detail::TunedGemmBlocking<T>;
+  auto lock = std::lock_guard(Tuned::mutex);
+  const auto blocking = detail::tune_and_store_gemm<T>(problem);
+  Tuned::publish(blocking);
+  return blocking;
+}
+
+// Blocking the eager ops use for T. On first use it is read from the
+// tuning cache; a miss is tuned and stored when VENUS_GEMM_AUTOTUNE is set
+// (to anything but 0), and falls back to default_gemm_blocking otherwise.
+// The first callers wait for a single lookup or tuning run; later ones read
+// the published result without locking.
+template <typename T> auto gemm_blocking() -> GemmBlocking {
+  if constexpr (detail::gemm_type_name<T>().empty()) {
+    return default_gemm_blocking<T>();
+  } else {
+    using Tuned = detail::TunedGemmBlocking<T>;
+    if (const auto *blocking = Tuned::current.load(std::memory_order_acquire)) {
+      return *blocking;
+    }
+
+    auto lock = std::lock_guard(Tuned::mutex);
+    // Resolved by another thread while this one waited
+    if (const auto *blocking = Tuned::current.load(std::memory_order_relaxed)) {
+      return *blocking;
+    }
+    std::optional<GemmBlocking> blocking;
+    if (const auto path = gemm_tuning_cache_path(); not path.empty()) {
+      blocking = load_gemm_blocking(path, gemm_tuning_key<T>());
+    }
+    if (not blocking) {
+      const char *env = std::getenv("VENUS_GEMM_AUTOTUNE");
+      blocking = env == nullptr or std::string_view(env) == "0"
+                     ? default_gemm_blocking<T>()
+                     : detail::tune_and_store_gemm<T>({});
+    }
+    Tuned::publish(*blocking);
+    return *blocking;
+  }
+}
+
+} // namespace venus::kernels
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <venus/kernels/gemm.hpp>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// Rows of A a matrix-vector product walks at once, so that every load of x
+// feeds that many accumulators
+inline constexpr std::size_t gemv_rows = 4;
+
+// Vectors of columns a vector-matrix product keeps in registers while it
+// walks down B
+inline constexpr std::size_t gevm_strip = 4;
+
+namespace detail {
+
+// y[r] = dot(A[r, :], x) for R consecutive rows of A, vectorized across K
+template <std::size_t R, typename T>
+void gemv_rows_simd(std::size_t K, const T *a, std::size_t lda, const T *x,
+                    T *y) {
+  using Ops = SimdOps<T>;
+  constexpr auto L = Ops::lanes;
+
+  typename Ops::type acc[R];
+  unroll<R>([&](auto r) { acc[r] = Ops::zero(); });
+  std::size_t k = 0;
+  for (; k + L <= K; k += L) {
+    const auto xv = Ops::load(x + k);
+    unroll<R>([&](auto r) {
+      acc[r] = Ops::fma(Ops::load(a + (r * lda) + k), xv, acc[r]);
+    });
+  }
+
+  unroll<R>([&](auto r) {
+    T lanes[L];
+    Ops::store(lanes, acc[r]);
+    T sum{};
+    for (std::size_t l = 0; l < L; ++l) {
+      sum += lanes[l];
+    }
+    for (auto kk = k; kk < K; ++kk) {
+      sum += a[(r * lda) + kk] * x[kk];
+    }
+    y[r] = sum;
+  });
+}
+
+// y[j] = sum over k of x[k] B[k, j] for W vectors of columns from column 0
+template <std::size_t W, typename T>
+void gevm_strip_simd(std::size_t K, const T *x, const T *b, std::size_t ldb,
+                     T *y) {
+  using Ops = SimdOps<T>;
+  constexpr auto L = Ops::lanes;
+
+  typename Ops::type acc[W];
+  unroll<W>([&](auto w) { acc[w] = Ops::zero(); });
+  for (std::size_t k = 0; k < K; ++k) {
+    const auto xv = Ops::broadcast(x[k]);
+    const auto *row = b + (k * ldb);
+    unroll<W>([&](auto w) {
+      acc[w] = Ops::fma(xv, Ops::load(row + (w * L)), acc[w]);
+    });
+  }
+  unroll<W>([&](auto w) { Ops::store(y + (w * L), acc[w]); });
+}
+
+} // namespace detail
+
+// y = A x for a row-major M x K matrix A with leading dimension lda,
+// computed in T. Rows are taken gemv_rows at a time and dotted with x in
+// SIMD registers across K when both operands are already T, then reduced
+// horizontally; anything else is converted element by element. Parallel
+// policies split the rows. Every row is summed in the same order whatever
+// the split.
+template <typename T, typename TA, typename TX, typename Policy>
+void gemv(Policy &&policy, std::size_t M, std::size_t K, const TA *a,
+          std::size_t lda, const TX *x, T *y) {
+  constexpr bool vectorized = detail::SimdOps<T>::enabled and
+                              std::is_same_v<TA, T> and std::is_same_v<TX, T>;
+  const auto groups = (M + gemv_rows - 1) / gemv_rows;
+
+  execution::for_each_chunk(
+      policy, groups,
+      [&](std::size_t group_begin, std::size_t group_end) {
+        for (auto group = group_begin; group < group_end; ++group) {
+          const auto i = group * gemv_rows;
+          if constexpr (vectorized) {
+            if (i + gemv_rows <= M) {
+              detail::gemv_rows_simd<gemv_rows>(K, a + (i * lda), lda, x,
+                                                y + i);
+              continue;
+            }
+            for (auto r = i; r < M; ++r) {
+              detail::gemv_rows_simd<1>(K, a + (r * lda), lda, x, y + r);
+            }
+          } else {
+            for (auto r = i; r < std::min(i + gemv_rows, M); ++r) {
+              T sum{};
+              for (std::size_t k = 0; k < K; ++k) {
+                sum += static_cast<T>(a[(r * lda) + k]) * static_cast<T>(x[k]);
+              }
+              y[r] = sum;
+            }
+          }
+        }
+      },
+      std::max<std::size_t>(execution::default_grain / (K * gemv_rows + 1),
+                            1));
+}
+
+// y = x^T B for a row-major K x N matrix B with leading dimension ldb,
+// computed in T. Columns are taken gevm_strip SIMD vectors at a time and
+// accumulated in registers down all of K, so y is written once; parallel
+// policies split the column strips.
+template <typename T, typename TX, typename TB, typename Policy>
+void gevm(Policy &&policy, std::size_t K, std::size_t N, const TX *x,
+          const TB *b, std::size_t ldb, T *y) {
+  constexpr bool vectorized = detail::SimdOps<T>::enabled and
+                              std::is_same_v<TX, T> and std::is_same_v<TB, T>;
+  constexpr auto width = gevm_strip * detail::SimdOps<T>::lanes;
+  const auto strips = (N + width - 1) / width;
+
+  execution::for_each_chunk(
+      policy, strips,
+      [&](std::size_t strip_begin, std::size_t strip_end) {
+        for (auto strip = strip_begin; strip < strip_end; ++strip) {
+          auto j = strip * width;
+          const auto end = std::min(j + width, N);
+          if constexpr (vectorized) {
+            constexpr auto L = detail::SimdOps<T>::lanes;
+            if (j + width <= N) {
+              detail::gevm_strip_simd<gevm_strip>(K, x, b + j, ldb, y + j);
+              continue;
+            }
+            for (; j + L <= end; j += L) {
+              detail::gevm_strip_simd<1>(K, x, b + j, ldb, y + j);
+            }
+          }
+          std::fill(y + j, y + end, T{});
+          for (std::size_t k = 0; k < K; ++k) {
+            const auto xk = static_cast<T>(x[k]);
+            const auto *row = b + (k * ldb);
+            for (auto jj = j; jj < end; ++jj) {
+              y[jj] += xk * static_cast<T>(row[jj]);
+            }
+          }
+        }
+      },
+      std::max<std::size_t>(execution::default_grain / (K * width + 1), 1));
+}
+
+// C = x y^T (or C += x y^T when accumulating) for C M x N row major with
+// leading dimension ldc, computed in T; parallel policies split the rows
+template <typename T, typename TX, typename TY, typename Policy>
+void ger(Policy &&policy, std::size_t M, std::size_t N, const TX *x,
+         const TY *y, T *c, std::size_t ldc, bool accumulate) {
+  execution::for_each_chunk(
+      policy, M,
+      [&](std::size_t row_begin, std::size_t row_end) {
+        for (auto i = row_begin; i < row_end; ++i) {
+          const auto xi = static_cast<T>(x[i]);
+          auto *row = c + (i * ldc);
+          if (accumulate) {
+            for (std::size_t j = 0; j < N; ++j) {
+              row[j] += xi * static_cast<T>(y[j]);
+            }
+          } else {
+            for (std::size_t j = 0; j < N; ++j) {
+              row[j] = xi * static_cast<T>(y[j]);
+            }
+          }
+        }
+      },
+      std::max<std::size_t>(execution::default_grain / (N + 1), 1));
+}
+
+} // namespace venus::kernels
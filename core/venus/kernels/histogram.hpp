@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// out[b] = number of i in [0, count) with bin_of(i) == b, for b < bins;
+// bin_of returns `bins` for elements that fall in no bin. Every thread
+// counts its share into a histogram of its own, and the partial histograms
+// are summed at the end, so no counter is shared while counting.
+template <typename BinOf, typename Policy>
+void count_bins(Policy &&policy, std::size_t count, std::size_t bins,
+                std::size_t *out, const BinOf &bin_of) {
+  const auto pieces = execution::partitions(policy, count);
+  auto partials = std::make_unique<std::size_t[]>(pieces * (bins + 1));
+
+  execution::for_each_chunk(
+      policy, pieces,
+      [&](std::size_t piece_begin, std::size_t piece_end) {
+        for (auto piece = piece_begin; piece < piece_end; ++piece) {
+          // The extra last bin takes the misses without a branch
+          auto *histogram = partials.get() + (piece * (bins + 1));
+          const auto end = ((piece + 1) * count) / pieces;
+          for (auto i = (piece * count) / pieces; i < end; ++i) {
+            ++histogram[bin_of(i)];
+          }
+        }
+      },
+      1);
+
+  execution::for_each_chunk(
+      policy, bins,
+      [&](std::size_t begin, std::size_t end) {
+        for (auto b = begin; b < end; ++b) {
+          std::size_t total = 0;
+          for (std::size_t piece = 0; piece < pieces; ++piece) {
+            total += partials[(piece * (bins + 1)) + b];
+          }
+          out[b] = total;
+        }
+      });
+}
+
+// Occurrences of each value in [0, bins) among the integers `in`, which the
+// caller has checked lie in that range
+template <typename T, typename Policy>
+void bincount(Policy &&policy, const T *in, std::size_t count,
+              std::size_t bins, std::size_t *out) {
+  count_bins(policy, count, bins, out, [in](std::size_t i) {
+    return static_cast<std::size_t>(in[i]);
+  });
+}
+
+// Counts of `in` over the bins [edges[b], edges[b + 1]), the last one closed
+// on the right. Edges are evenly spaced; the bin is found arithmetically and
+// then checked against the edges themselves, so values on an edge land on
+// the same side as a comparison would put them. Values outside the edges
+// and NaN are not counted.
+template <typename T, typename E, typename Policy>
+void histogram(Policy &&policy, const T *in, std::size_t count,
+               const E *edges, std::size_t bins, std::size_t *out) {
+  const auto lo = edges[0];
+  const auto hi = edges[bins];
+  const auto scale = static_cast<E>(bins) / (hi - lo);
+
+  count_bins(policy, count, bins, out, [&](std::size_t i) {
+    const auto value = static_cast<E>(in[i]);
+    if (not(value >= lo and value <= hi)) {
+      return bins;
+    }
+    auto b = std::min(static_cast<std::size_t>((value - lo) * scale), bins - 1);
+    if (value < edges[b]) {
+      --b;
+    } else if (b + 1 < bins and value >= edges[b + 1]) {
+      ++b;
+    }
+    return b;
+  });
+}
+
+} // namespace venus::kernels
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace venus::kernels {
+
+// exp(x) for float within 1 ulp, branch-free so loops over it vectorize
+// (std::exp is a library call the compiler cannot vectorize without
+// -ffast-math). Range reduction x = n ln2 + r, a degree 6 polynomial for
+// e^r (Cephes expf), and 2^n assembled in the exponent bits. Results
+// underflow to 0 and overflow to +inf as expected; NaN propagates.
+inline auto fast_exp(float x) -> float {
+  constexpr float log2e = 1.44269504088896341f;
+  constexpr float ln2_hi = 0.693359375f;
+  constexpr float ln2_lo = -2.12194440e-4f;
+  // exp(-104) is below half the smallest subnormal and exp(89) above the
+  // largest float, so clamping there still rounds to 0 and +inf
+  constexpr float lowest = -104.0f;
+  constexpr float highest = 89.0f;
+  // 1.5 * 2^23: adding it rounds to an integer kept in the low mantissa bits
+  constexpr float round_magic = 12582912.0f;
+
+  // The clamp blends bits under comparison masks: a min/max or select on
+  // floats is turned back into branches by GCC and stops vectorization.
+  // NaN fails both comparisons and passes through.
+  const auto below = -static_cast<std::int32_t>(x < lowest);
+  const auto above = -static_cast<std::int32_t>(x > highest);
+  const auto bits = (std::bit_cast<std::int32_t>(x) & ~(below | above)) |
+                    (std::bit_cast<std::int32_t>(lowest) & below) |
+                    (std::bit_cast<std::int32_t>(highest) & above);
+  const float clamped = std::bit_cast<float>(bits);
+  const float shifted = (clamped * log2e) + round_magic;
+  const auto exponent = std::bit_cast<std::int32_t>(shifted) -
+                        std::bit_cast<std::int32_t>(round_magic);
+  const auto n = static_cast<float>(exponent);
+
+  const float r = (clamped - (n * ln2_hi)) - (n * ln2_lo);
+  float p = 1.9875691500e-4f;
+  p = (p * r) + 1.3981999507e-3f;
+  p = (p * r) + 8.3334519073e-3f;
+  p = (p * r) + 4.1665795894e-2f;
+  p = (p * r) + 1.6666665459e-1f;
+  p = (p * r) + 5.0000001201e-1f;
+  const float e_r = (p * r * r) + r + 1.0f;
+
+  // 2^n as two normal halves, so n in [-150, 128] needs no special cases
+  const auto half = exponent / 2;
+  const float scale_lo = std::bit_cast<float>((half + 127) << 23);
+  const float scale_hi = std::bit_cast<float>((exponent - half + 127) << 23);
+  return e_r * scale_lo * scale_hi;
+}
+
+// exp for the accumulator types of the kernels: the vectorizable
+// approximation for float, the library for double
+template <typename T> auto exp_of(T x) -> T {
+  if constexpr (std::is_same_v<T, float>) {
+    return fast_exp(x);
+  } else {
+    return std::exp(x);
+  }
+}
+
+} // namespace venus::kernels
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// Elements tested between checks for an early exit. Within a block the test
+// has no branches, so it compiles to SIMD compares folded into a mask, and a
+// hit is noticed at most one block after it is read.
+inline constexpr std::size_t predicate_block = 512;
+
+// Whether pred(i) holds for any i in [0, count). Every thread stops at the
+// end of the block where it finds a hit, and skips its remaining blocks once
+// another thread has found one.
+template <typename Pred, typename Policy>
+auto any_of(Policy &&policy, std::size_t count, const Pred &pred) -> bool {
+  std::atomic<bool> found{false};
+  execution::for_each_chunk(
+      policy, count, [&](std::size_t begin, std::size_t end) {
+        for (auto block = begin; block < end; block += predicate_block) {
+          if (found.load(std::memory_order_relaxed)) {
+            return;
+          }
+          const auto block_end = std::min(block + predicate_block, end);
+          std::uint32_t hits = 0;
+          for (auto i = block; i < block_end; ++i) {
+            hits |= pred(i) ? 1U : 0U;
+          }
+          if (hits != 0) {
+            found.store(true, std::memory_order_relaxed);
+            return;
+          }
+        }
+      });
+  return found.load(std::memory_order_relaxed);
+}
+
+// Number of i in [0, count) for which pred(i) holds, counted per piece in
+// blocks narrow enough for 32-bit lanes
+template <typename Pred, typename Policy>
+auto count_if(Policy &&policy, std::size_t count, const Pred &pred)
+    -> std::size_t {
+  const auto pieces = execution::partitions(policy, count);
+  auto partials = std::make_unique<std::size_t[]>(pieces);
+
+  execution::for_each_chunk(
+      policy, pieces,
+      [&](std::size_t piece_begin, std::size_t piece_end) {
+        for (auto piece = piece_begin; piece < piece_end; ++piece) {
+          const auto end = ((piece + 1) * count) / pieces;
+          for (auto block = (piece * count) / pieces; block < end;
+               block += predicate_block) {
+            const auto block_end = std::min(block + predicate_block, end);
+            std::uint32_t hits = 0;
+            for (auto i = block; i < block_end; ++i) {
+              hits += pred(i) ? 1U : 0U;
+            }
+            partials[piece] += hits;
+          }
+        }
+      },
+      1);
+  return std::accumulate(partials.get(), partials.get() + pieces,
+                         std::size_t{0});
+}
+
+} // namespace venus::kernels
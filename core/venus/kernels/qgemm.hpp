@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <venus/kernels/cache_info.hpp>
+#include <venus/kernels/gemm.hpp>
+
+#if defined(__AVX512VNNI__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace venus::kernels {
+
+namespace detail {
+
+inline auto dot_s8_scalar(const std::int8_t *a, const std::int8_t *b,
+                          std::size_t count) -> std::int32_t {
+  std::int32_t sum = 0;
+  for (std::size_t k = 0; k < count; ++k) {
+    sum += static_cast<std::int32_t>(a[k]) * static_cast<std::int32_t>(b[k]);
+  }
+  return sum;
+}
+
+// Columns of Bt per pass, each load of A being reused for all of them
+inline constexpr std::size_t qgemm_nr = 4;
+
+#if defined(__AVX512VNNI__) && defined(__AVX512BW__)
+// Rows of A per pass over a strip of Bt, each load of Bt being reused for
+// all of them
+inline constexpr std::size_t qgemm_mr = 4;
+
+// Rows x qgemm_nr outputs at C (leading dimension ldc). vpdpbusd multiplies
+// unsigned by signed bytes, so A is shifted by +128 and 128 * col_sums
+// taken back out. The K tail is a masked load of zeros, which adds nothing
+// to the shifted product either.
+template <std::size_t Rows>
+void qgemm_tile(std::size_t K, const std::int8_t *A, const std::int8_t *Bt,
+                const std::int32_t *col_sums, std::int32_t *C,
+                std::size_t ldc) {
+  constexpr std::size_t step = 64;
+  const auto flip = _mm512_set1_epi8(static_cast<char>(0x80));
+  __m512i acc[Rows][qgemm_nr];
+  unroll<Rows>([&](auto r) {
+    unroll<qgemm_nr>([&](auto c) { acc[r][c] = _mm512_setzero_si512(); });
+  });
+  for (std::size_t k = 0; k < K; k += step) {
+    const auto mask = K - k >= step ? ~__mmask64{0}
+                                    : (__mmask64{1} << (K - k)) - 1;
+    __m512i b[qgemm_nr];
+    unroll<qgemm_nr>([&](auto c) {
+      b[c] = _mm512_maskz_loadu_epi8(mask, Bt + (c * K) + k);
+    });
+    unroll<Rows>([&](auto r) {
+      const auto a = _mm512_xor_si512(
+          _mm512_maskz_loadu_epi8(mask, A + (r * K) + k), flip);
+      unroll<qgemm_nr>([&](auto c) {
+        acc[r][c] = _mm512_dpbusd_epi32(acc[r][c], a, b[c]);
+      });
+    });
+  }
+  unroll<Rows>([&](auto r) {
+    unroll<qgemm_nr>([&](auto c) {
+      C[(r * ldc) + c] =
+          _mm512_reduce_add_epi32(acc[r][c]) - (128 * col_sums[c]);
+    });
+  });
+}
+#elif defined(__AVX2__)
+inline constexpr std::size_t qgemm_mr = 2;
+
+// Rows x qgemm_nr outputs at C (leading dimension ldc). Sign-extends to 16
+// bits and uses vpmaddwd, which cannot saturate (unlike vpmaddubsw on
+// shifted operands).
+template <std::size_t Rows>
+void qgemm_tile(std::size_t K, const std::int8_t *A, const std::int8_t *Bt,
+                const std::int32_t * /*col_sums*/, std::int32_t *C,
+                std::size_t ldc) {
+  constexpr std::size_t step = 16;
+  const std::size_t k_vec = K - (K % step);
+  __m256i acc[Rows][qgemm_nr];
+  unroll<Rows>([&](auto r) {
+    unroll<qgemm_nr>([&](auto c) { acc[r][c] = _mm256_setzero_si256(); });
+  });
+  for (std::size_t k = 0; k < k_vec; k += step) {
+    __m256i a[Rows];
+    unroll<Rows>([&](auto r) {
+      a[r] = _mm256_cvtepi8_epi16(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(A + (r * K) + k)));
+    });
+    unroll<qgemm_nr>([&](auto c) {
+      const auto b = _mm256_cvtepi8_epi16(_mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(Bt + (c * K) + k)));
+      unroll<Rows>([&](auto r) {
+        acc[r][c] = _mm256_add_epi32(acc[r][c], _mm256_madd_epi16(a[r], b));
+      });
+    });
+  }
+  unroll<Rows>([&](auto r) {
+    unroll<qgemm_nr>([&](auto c) {
+      const auto halves = _mm_add_epi32(_mm256_castsi256_si128(acc[r][c]),
+                                        _mm256_extracti128_si256(acc[r][c], 1));
+      const auto pairs = _mm_hadd_epi32(halves, halves);
+      const auto total = _mm_hadd_epi32(pairs, pairs);
+      C[(r * ldc) + c] =
+          _mm_cvtsi128_si32(total) +
+          dot_s8_scalar(A + (r * K) + k_vec, Bt + (c * K) + k_vec, K - k_vec);
+    });
+  });
+}
+#endif
+
+} // namespace detail
+
+// C[i, j] = sum_k A[i, k] * Bt[j, k], int8 x int8 -> int32 with exact
+// accumulation. A is M x K and Bt (B transposed) is N x K, both row major, so
+// every output is a dot product of two contiguous rows; col_sums[j] is the
+// sum of row j of Bt. Register tiles of qgemm_mr rows of A by qgemm_nr rows
+// of Bt reuse every load across the tile, and blocks of rows of A sized to
+// half of L2 are kept there while every strip of Bt passes over them.
+inline void qgemm_s8s8s32(std::size_t M, std::size_t N, std::size_t K,
+                          const std::int8_t *A, const std::int8_t *Bt,
+                          const std::int32_t *col_sums, std::int32_t *C) {
+#if (defined(__AVX512VNNI__) && defined(__AVX512BW__)) || defined(__AVX2__)
+  constexpr auto mr = detail::qgemm_mr;
+  constexpr auto nr = detail::qgemm_nr;
+  const auto block =
+      std::max(((cache_sizes().l2 / 2) / std::max<std::size_t>(K, 1)) /
+                   mr * mr,
+               mr);
+
+  for (std::size_t i_begin = 0; i_begin < M; i_begin += block) {
+    const auto i_end = std::min(i_begin + block, M);
+    std::size_t j = 0;
+    for (; j + nr <= N; j += nr) {
+      const auto *strip = Bt + (j * K);
+      std::size_t i = i_begin;
+      for (; i + mr <= i_end; i += mr) {
+        detail::qgemm_tile<mr>(K, A + (i * K), strip, col_sums + j,
+                               C + (i * N) + j, N);
+      }
+      for (; i < i_end; ++i) {
+        detail::qgemm_tile<1>(K, A + (i * K), strip, col_sums + j,
+                              C + (i * N) + j, N);
+      }
+    }
+    for (; j < N; ++j) {
+      for (auto i = i_begin; i < i_end; ++i) {
+        C[(i * N) + j] = detail::dot_s8_scalar(A + (i * K), Bt + (j * K), K);
+      }
+    }
+  }
+#else
+  static_cast<void>(col_sums);
+  for (std::size_t i = 0; i < M; ++i) {
+    for (std::size_t j = 0; j < N; ++j) {
+      C[(i * N) + j] = detail::dot_s8_scalar(A + (i * K), Bt + (j * K), K);
+    }
+  }
+#endif
+}
+
+} // namespace venus::kernels
@@ -0,0 +1,775 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <venus/float16.hpp>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// Independent accumulators kept by contiguous reductions: one 64-byte
+// register's worth, so the loop maps onto SIMD lanes (AVX-512, or two and
+// four registers on AVX2 and NEON) instead of a serial dependency chain
+template <typename T>
+inline constexpr std::size_t accumulator_lanes =
+    std::max<std::size_t>(64 / sizeof(T), 1);
+
+// Reducers describe a reduction as init / push / merge / finalize, so the
+// engine can split the work and combine partial results in any grouping.
+// Additive reducers (sums and means) can also be compensated or folded
+// pairwise.
+
+template <typename T> struct SumReducer {
+  static constexpr bool additive = true;
+  using value_type = T;
+  using accumulator_type = accumulator_t<T>;
+  using result_type = T;
+
+  static constexpr auto init() -> accumulator_type {
+    return accumulator_type{};
+  }
+  static constexpr auto push(accumulator_type acc, value_type value)
+      -> accumulator_type {
+    return acc + static_cast<accumulator_type>(value);
+  }
+  static constexpr auto merge(accumulator_type lhs, accumulator_type rhs)
+      -> accumulator_type {
+    return lhs + rhs;
+  }
+  static constexpr auto finalize(accumulator_type acc, std::size_t /*count*/)
+      -> result_type {
+    return static_cast<result_type>(acc);
+  }
+};
+
+template <typename T> struct ProdReducer {
+  static constexpr bool additive = false;
+  using value_type = T;
+  using accumulator_type = accumulator_t<T>;
+  using result_type = T;
+
+  static constexpr auto init() -> accumulator_type {
+    return accumulator_type{1};
+  }
+  static constexpr auto push(accumulator_type acc, value_type value)
+      -> accumulator_type {
+    return acc * static_cast<accumulator_type>(value);
+  }
+  static constexpr auto merge(accumulator_type lhs, accumulator_type rhs)
+      -> accumulator_type {
+    return lhs * rhs;
+  }
+  static constexpr auto finalize(accumulator_type acc, std::size_t /*count*/)
+      -> result_type {
+    return static_cast<result_type>(acc);
+  }
+};
+
+// Integer means are computed in double, floating means keep their type
+template <typename T> struct MeanReducer {
+  static constexpr bool additive = true;
+  using value_type = T;
+  using result_type =
+      std::conditional_t<std::is_integral_v<T>, double, T>;
+  using accumulator_type = accumulator_t<result_type>;
+
+  static constexpr auto init() -> accumulator_type {
+    return accumulator_type{};
+  }
+  static constexpr auto push(accumulator_type acc, value_type value)
+      -> accumulator_type {
+    return acc + static_cast<accumulator_type>(value);
+  }
+  static constexpr auto merge(accumulator_type lhs, accumulator_type rhs)
+      -> accumulator_type {
+    return lhs + rhs;
+  }
+  static constexpr auto finalize(accumulator_type acc, std::size_t count)
+      -> result_type {
+    return static_cast<result_type>(acc / static_cast<accumulator_type>(count));
+  }
+};
+
+template <typename T> struct MaxReducer {
+  static constexpr bool additive = false;
+  using value_type = T;
+  using accumulator_type = accumulator_t<T>;
+  using result_type = T;
+
+  static constexpr auto init() -> accumulator_type {
+    if constexpr (std::numeric_limits<accumulator_type>::has_infinity) {
+      return -std::numeric_limits<accumulator_type>::infinity();
+    } else {
+      return std::numeric_limits<accumulator_type>::lowest();
+    }
+  }
+  static constexpr auto push(accumulator_type acc, value_type value)
+      -> accumulator_type {
+    const auto candidate = static_cast<accumulator_type>(value);
+    return candidate > acc ? candidate : acc;
+  }
+  static constexpr auto merge(accumulator_type lhs, accumulator_type rhs)
+      -> accumulator_type {
+    return rhs > lhs ? rhs : lhs;
+  }
+  static constexpr auto finalize(accumulator_type acc, std::size_t /*count*/)
+      -> result_type {
+    return static_cast<result_type>(acc);
+  }
+};
+
+template <typename T> struct MinReducer {
+  static constexpr bool additive = false;
+  using value_type = T;
+  using accumulator_type = accumulator_t<T>;
+  using result_type = T;
+
+  static constexpr auto init() -> accumulator_type {
+    if constexpr (std::numeric_limits<accumulator_type>::has_infinity) {
+      return std::numeric_limits<accumulator_type>::infinity();
+    } else {
+      return std::numeric_limits<accumulator_type>::max();
+    }
+  }
+  static constexpr auto push(accumulator_type acc, value_type value)
+      -> accumulator_type {
+    const auto candidate = static_cast<accumulator_type>(value);
+    return candidate < acc ? candidate : acc;
+  }
+  static constexpr auto merge(accumulator_type lhs, accumulator_type rhs)
+      -> accumulator_type {
+    return rhs < lhs ? rhs : lhs;
+  }
+  static constexpr auto finalize(accumulator_type acc, std::size_t /*count*/)
+      -> result_type {
+    return static_cast<result_type>(acc);
+  }
+};
+
+template <typename T> struct AnyReducer {
+  static constexpr bool additive = false;
+  using value_type = T;
+  using accumulator_type = bool;
+  using result_type = bool;
+  static constexpr accumulator_type absorbing = true;
+
+  static constexpr auto init() -> accumulator_type { return false; }
+  static constexpr auto push(accumulator_type acc, value_type value)
+      -> accumulator_type {
+    return acc | (value != value_type{});
+  }
+  static constexpr auto merge(accumulator_type lhs, accumulator_type rhs)
+      -> accumulator_type {
+    return lhs | rhs;
+  }
+  static constexpr auto finalize(accumulator_type acc, std::size_t /*count*/)
+      -> result_type {
+    return acc;
+  }
+};
+
+template <typename T> struct AllReducer {
+  static constexpr bool additive = false;
+  using value_type = T;
+  using accumulator_type = bool;
+  using result_type = bool;
+  static constexpr accumulator_type absorbing = false;
+
+  static constexpr auto init() -> accumulator_type { return true; }
+  static constexpr auto push(accumulator_type acc, value_type value)
+      -> accumulator_type {
+    return acc & (value != value_type{});
+  }
+  static constexpr auto merge(accumulator_type lhs, accumulator_type rhs)
+      -> accumulator_type {
+    return lhs & rhs;
+  }
+  static constexpr auto finalize(accumulator_type acc, std::size_t /*count*/)
+      -> result_type {
+    return acc;
+  }
+};
+
+// Reducers with an absorbing accumulator, which no later push changes (true
+// for any, false for all): a whole-tensor reduction stops at the first
+// element that reaches it
+template <typename Op>
+concept Absorbing = requires { Op::absorbing; };
+
+template <typename T> struct CountNonzeroReducer {
+  static constexpr bool additive = false;
+  using value_type = T;
+  using accumulator_type = std::size_t;
+  using result_type = std::size_t;
+
+  static constexpr auto init() -> accumulator_type { return 0; }
+  static constexpr auto push(accumulator_type acc, value_type value)
+      -> accumulator_type {
+    return acc + (value != value_type{} ? 1 : 0);
+  }
+  static constexpr auto merge(accumulator_type lhs, accumulator_type rhs)
+      -> accumulator_type {
+    return lhs + rhs;
+  }
+  static constexpr auto finalize(accumulator_type acc, std::size_t /*count*/)
+      -> result_type {
+    return acc;
+  }
+};
+
+// Count, mean and sum of squared deviations (m2) of a set of values
+template <typename T> struct Moments {
+  std::size_t count = 0;
+  T mean{};
+  T m2{};
+};
+
+// Mean and population variance of a reduced set
+template <typename T> struct MeanVariance {
+  T mean{};
+  T variance{};
+};
+
+// One-pass statistics: Welford's update per element and Chan's formula to
+// merge partial moments. Contiguous runs use fold() instead, which keeps the
+// inner loop free of divisions. Integer inputs are accumulated in double.
+template <typename T> struct MomentsReducer {
+  static constexpr bool additive = false;
+  using value_type = T;
+  using moment_type =
+      accumulator_t<std::conditional_t<std::is_integral_v<T>, double, T>>;
+  using accumulator_type = Moments<moment_type>;
+  using result_type = MeanVariance<moment_type>;
+
+  static constexpr auto init() -> accumulator_type { return {}; }
+  static constexpr auto push(accumulator_type acc, value_type value)
+      -> accumulator_type {
+    const auto x = static_cast<moment_type>(value);
+    ++acc.count;
+    const auto delta = x - acc.mean;
+    acc.mean += delta / static_cast<moment_type>(acc.count);
+    acc.m2 += delta * (x - acc.mean);
+    return acc;
+  }
+  static constexpr auto merge(accumulator_type lhs, accumulator_type rhs)
+      -> accumulator_type {
+    if (lhs.count == 0 or rhs.count == 0) {
+      return lhs.count == 0 ? rhs : lhs;
+    }
+    const auto count = lhs.count + rhs.count;
+    const auto n_lhs = static_cast<moment_type>(lhs.count);
+    const auto n_rhs = static_cast<moment_type>(rhs.count);
+    const auto n = static_cast<moment_type>(count);
+    const auto delta = rhs.mean - lhs.mean;
+    return {count, lhs.mean + (delta * (n_rhs / n)),
+            lhs.m2 + rhs.m2 + (delta * delta * (n_lhs * n_rhs / n))};
+  }
+  static constexpr auto finalize(accumulator_type acc, std::size_t count)
+      -> result_type {
+    return {acc.mean, acc.m2 / static_cast<moment_type>(count)};
+  }
+
+  // Leaves of a fixed number of elements are summed with per-lane
+  // accumulators, shifted by the leaf's first value so the sum of squares
+  // does not cancel, and then merged into the running moments
+  static auto fold(const value_type *in, std::size_t count) -> accumulator_type {
+    constexpr auto L = accumulator_lanes<moment_type>;
+    constexpr auto leaf = 8 * L;
+
+    auto acc = init();
+    std::size_t i = 0;
+    for (; i + leaf <= count; i += leaf) {
+      const auto shift = static_cast<moment_type>(in[i]);
+      std::array<moment_type, L> sums{};
+      std::array<moment_type, L> squares{};
+      for (std::size_t j = i; j < i + leaf; j += L) {
+        for (std::size_t l = 0; l < L; ++l) {
+          const auto d = static_cast<moment_type>(in[j + l]) - shift;
+          sums[l] += d;
+          squares[l] += d * d;
+        }
+      }
+      moment_type sum{};
+      moment_type square{};
+      for (std::size_t l = 0; l < L; ++l) {
+        sum += sums[l];
+        square += squares[l];
+      }
+      const auto mean = sum / static_cast<moment_type>(leaf);
+      acc = merge(acc, {leaf, shift + mean, std::max(square - (sum * mean),
+                                                     moment_type{})});
+    }
+    for (; i < count; ++i) {
+      acc = push(acc, in[i]);
+    }
+    return acc;
+  }
+};
+
+// Population variance and standard deviation (divided by n), in the same
+// type as mean
+template <typename T> struct VarianceReducer : MomentsReducer<T> {
+  using result_type = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+  static constexpr auto finalize(
+      typename MomentsReducer<T>::accumulator_type acc, std::size_t count)
+      -> result_type {
+    return static_cast<result_type>(
+        MomentsReducer<T>::finalize(acc, count).variance);
+  }
+};
+
+template <typename T> struct StddevReducer : MomentsReducer<T> {
+  using result_type = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+  static auto finalize(typename MomentsReducer<T>::accumulator_type acc,
+                       std::size_t count) -> result_type {
+    return static_cast<result_type>(
+        std::sqrt(MomentsReducer<T>::finalize(acc, count).variance));
+  }
+};
+
+// Neumaier's variant of Kahan summation over an additive reducer: the
+// rounding error of every addition is kept in a separate term and added back
+// once at the end. The select is branch-free, so the lanes still vectorize.
+template <typename Reducer> struct Compensated {
+  static_assert(Reducer::additive, "only additive reductions are compensated");
+
+  static constexpr bool additive = true;
+  using value_type = typename Reducer::value_type;
+  using result_type = typename Reducer::result_type;
+  using base_type = typename Reducer::accumulator_type;
+
+  struct accumulator_type {
+    base_type sum{};
+    base_type compensation{};
+  };
+
+  static constexpr auto init() -> accumulator_type {
+    return {Reducer::init(), base_type{}};
+  }
+  static constexpr auto add(accumulator_type acc, base_type term)
+      -> accumulator_type {
+    const auto total = acc.sum + term;
+    const auto sum_magnitude = acc.sum < base_type{} ? -acc.sum : acc.sum;
+    const auto term_magnitude = term < base_type{} ? -term : term;
+    const bool sum_larger = sum_magnitude >= term_magnitude;
+    const auto larger = sum_larger ? acc.sum : term;
+    const auto smaller = sum_larger ? term : acc.sum;
+    return {total, acc.compensation + ((larger - total) + smaller)};
+  }
+  static constexpr auto term(value_type value) -> base_type {
+    return Reducer::push(Reducer::init(), value);
+  }
+  static constexpr auto push(accumulator_type acc, value_type value)
+      -> accumulator_type {
+    return add(acc, term(value));
+  }
+  static constexpr auto merge(accumulator_type lhs, accumulator_type rhs)
+      -> accumulator_type {
+    auto result = add(lhs, rhs.sum);
+    result.compensation += rhs.compensation;
+    return result;
+  }
+  static constexpr auto finalize(accumulator_type acc, std::size_t count)
+      -> result_type {
+    // Infinite or NaN sums carry a NaN compensation; keep the sum as is
+    const bool finite = acc.sum - acc.sum == base_type{};
+    return Reducer::finalize(finite ? acc.sum + acc.compensation : acc.sum,
+                             count);
+  }
+};
+
+// Elements below which pairwise folding stops splitting: eight additions per
+// lane, as in NumPy's pairwise sum
+template <typename Acc>
+inline constexpr std::size_t pairwise_leaf = 8 * accumulator_lanes<Acc>;
+
+// Folds load(i) for i in [begin, end) into one accumulator, spread over
+// independent lanes. Pairwise folding first halves the range down to
+// pairwise_leaf elements, so rounding errors grow with log(count) rather
+// than count.
+template <typename Reducer, bool Pairwise, typename Load>
+auto fold_lanes(std::size_t begin, std::size_t end, const Load &load) ->
+    typename Reducer::accumulator_type {
+  using Acc = typename Reducer::accumulator_type;
+  constexpr auto L = accumulator_lanes<Acc>;
+
+  if constexpr (Pairwise) {
+    if (end - begin > pairwise_leaf<Acc>) {
+      const auto half = ((((end - begin) / 2) + L - 1) / L) * L;
+      return Reducer::merge(
+          fold_lanes<Reducer, Pairwise>(begin, begin + half, load),
+          fold_lanes<Reducer, Pairwise>(begin + half, end, load));
+    }
+  }
+
+  auto acc = Reducer::init();
+  auto i = begin;
+  if constexpr (requires { typename Reducer::base_type; }) {
+    // Compensated lanes are kept as separate sum and error arrays, which
+    // vectorize where an array of pairs does not
+    using Base = typename Reducer::base_type;
+    constexpr auto BL = accumulator_lanes<Base>;
+    std::array<Base, BL> sums;
+    std::array<Base, BL> errors{};
+    sums.fill(Reducer::init().sum);
+    for (; i + BL <= end; i += BL) {
+      for (std::size_t l = 0; l < BL; ++l) {
+        const auto next =
+            Reducer::add({sums[l], Base{}}, Reducer::term(load(i + l)));
+        sums[l] = next.sum;
+        errors[l] += next.compensation;
+      }
+    }
+    for (std::size_t l = 0; l < BL; ++l) {
+      acc = Reducer::merge(acc, {sums[l], errors[l]});
+    }
+  } else {
+    std::array<Acc, L> lanes;
+    lanes.fill(Reducer::init());
+    for (; i + L <= end; i += L) {
+      for (std::size_t l = 0; l < L; ++l) {
+        lanes[l] = Reducer::push(lanes[l], load(i + l));
+      }
+    }
+    for (std::size_t l = 0; l < L; ++l) {
+      acc = Reducer::merge(acc, lanes[l]);
+    }
+  }
+  for (; i < end; ++i) {
+    acc = Reducer::push(acc, load(i));
+  }
+  return acc;
+}
+
+// Folds a contiguous run into one accumulator
+template <typename Reducer, bool Pairwise = false>
+auto reduce_contiguous(const typename Reducer::value_type *in,
+                       std::size_t count) ->
+    typename Reducer::accumulator_type {
+  if constexpr (requires { Reducer::fold(in, count); }) {
+    return Reducer::fold(in, count);
+  } else {
+    return fold_lanes<Reducer, Pairwise>(
+        0, count, [in](std::size_t i) { return in[i]; });
+  }
+}
+
+// Reduced elements per block. Blocks are folded independently and their
+// partial results combined in a fixed pairwise tree, so the grouping of
+// every floating point operation depends on the shape alone: seq, par and
+// any thread count give bitwise identical results.
+inline constexpr std::size_t reduction_block = 4096;
+
+// Combines partials[0 .. count) (each `width` accumulators wide, restricted
+// to columns [begin, end)) into partials[0] by a fixed pairwise tree
+template <typename Reducer>
+void tree_combine(typename Reducer::accumulator_type *partials,
+                  std::size_t count, std::size_t width, std::size_t begin,
+                  std::size_t end) {
+  for (std::size_t step = 1; step < count; step *= 2) {
+    for (std::size_t c = 0; c + step < count; c += 2 * step) {
+      auto *dst = partials + (c * width);
+      const auto *src = partials + ((c + step) * width);
+      for (auto i = begin; i < end; ++i) {
+        dst[i] = Reducer::merge(dst[i], src[i]);
+      }
+    }
+  }
+}
+
+// Row-major shape split into its kept and reduced axes. Runs of adjacent
+// kept (or reduced) axes are merged and unit axes dropped, and each group
+// remembers its stride in the input.
+template <std::size_t Rank> struct ReductionLayout {
+  struct Axes {
+    std::array<std::size_t, Rank> extents{};
+    std::array<std::size_t, Rank> strides{};
+    std::size_t groups = 0;
+    std::size_t count = 1;
+
+    void append(std::size_t extent, std::size_t stride) {
+      extents[groups] = extent;
+      strides[groups] = stride;
+      ++groups;
+      count *= extent;
+    }
+
+    // Input offset of the index-th element, in row-major order over the axes
+    [[nodiscard]] auto offset(std::size_t index) const -> std::size_t {
+      std::size_t result = 0;
+      for (std::size_t g = groups; g-- > 0;) {
+        result += (index % extents[g]) * strides[g];
+        index /= extents[g];
+      }
+      return result;
+    }
+  };
+
+  Axes kept;
+  Axes reduced;
+  // Extent of the innermost (contiguous) group and whether it is reduced:
+  // reduced means every output folds contiguous runs, kept means every
+  // input row is added onto a contiguous output row
+  std::size_t inner = 1;
+  bool inner_reduced = true;
+
+  ReductionLayout(const std::array<std::size_t, Rank> &shape,
+                  const std::array<bool, Rank> &reduce_mask) {
+    std::array<std::size_t, Rank> extents{};
+    std::array<bool, Rank> reduced_group{};
+    std::size_t groups = 0;
+    for (std::size_t d = 0; d < Rank; ++d) {
+      if (shape[d] == 1) {
+        continue;
+      }
+      if (groups > 0 and reduced_group[groups - 1] == reduce_mask[d]) {
+        extents[groups - 1] *= shape[d];
+      } else {
+        extents[groups] = shape[d];
+        reduced_group[groups] = reduce_mask[d];
+        ++groups;
+      }
+    }
+
+    std::array<std::size_t, Rank> strides{};
+    for (std::size_t g = groups, stride = 1; g-- > 0;) {
+      strides[g] = stride;
+      stride *= extents[g];
+    }
+    for (std::size_t g = 0; g < groups; ++g) {
+      (reduced_group[g] ? reduced : kept).append(extents[g], strides[g]);
+    }
+
+    if (groups > 0) {
+      inner = extents[groups - 1];
+      inner_reduced = reduced_group[groups - 1];
+    }
+  }
+};
+
+// Folds reduced indices [r_begin, r_end) of the output whose kept axes start
+// at `base`, when the reduced indices run contiguously in memory
+template <typename Reducer, bool Pairwise, std::size_t Rank>
+auto fold_reduced(const typename Reducer::value_type *in,
+                  const ReductionLayout<Rank> &layout, std::size_t base,
+                  std::size_t r_begin, std::size_t r_end) ->
+    typename Reducer::accumulator_type {
+  using Acc = typename Reducer::accumulator_type;
+  const auto inner = layout.inner;
+
+  if constexpr (Pairwise) {
+    // Also halve across runs, so many short runs are not folded serially
+    if (r_end - r_begin > pairwise_leaf<Acc> and
+        r_begin / inner != (r_end - 1) / inner) {
+      const auto mid = r_begin + ((r_end - r_begin) / 2);
+      return Reducer::merge(
+          fold_reduced<Reducer, Pairwise>(in, layout, base, r_begin, mid),
+          fold_reduced<Reducer, Pairwise>(in, layout, base, mid, r_end));
+    }
+  }
+
+  auto folded = Reducer::init();
+  for (auto r = r_begin; r < r_end;) {
+    const auto j = r % inner;
+    const auto run = std::min(r_end - r, inner - j);
+    folded = Reducer::merge(
+        folded, reduce_contiguous<Reducer, Pairwise>(
+                    in + base + layout.reduced.offset(r - j) + j, run));
+    r += run;
+  }
+  return folded;
+}
+
+// Adds input rows [r_begin, r_end) onto the contiguous output rows in `out`.
+// Pairwise folding adds the right half into the next scratch level and
+// merges it back, one level per halving.
+template <typename Reducer, bool Pairwise, std::size_t Rank>
+void fold_rows(const typename Reducer::value_type *in,
+               const ReductionLayout<Rank> &layout,
+               const std::size_t *row_offsets, std::size_t rows,
+               std::size_t r_begin, std::size_t r_end,
+               typename Reducer::accumulator_type *out,
+               typename Reducer::accumulator_type *scratch) {
+  using Acc = typename Reducer::accumulator_type;
+  const auto inner = layout.inner;
+  const auto width = rows * inner;
+
+  if constexpr (Pairwise) {
+    if (r_end - r_begin > pairwise_leaf<Acc>) {
+      const auto mid = r_begin + ((r_end - r_begin) / 2);
+      fold_rows<Reducer, Pairwise>(in, layout, row_offsets, rows, r_begin, mid,
+                                   out, scratch + width);
+      fold_rows<Reducer, Pairwise>(in, layout, row_offsets, rows, mid, r_end,
+                                   scratch, scratch + width);
+      for (std::size_t o = 0; o < width; ++o) {
+        out[o] = Reducer::merge(out[o], scratch[o]);
+      }
+      return;
+    }
+  }
+
+  std::fill(out, out + width, Reducer::init());
+  for (auto r = r_begin; r < r_end; ++r) {
+    const auto reduced_offset = layout.reduced.offset(r);
+    for (std::size_t row = 0; row < rows; ++row) {
+      const auto *row_in = in + row_offsets[row] + reduced_offset;
+      auto *row_out = out + (row * inner);
+      for (std::size_t j = 0; j < inner; ++j) {
+        row_out[j] = Reducer::push(row_out[j], row_in[j]);
+      }
+    }
+  }
+}
+
+// Folds reduced indices [r_begin, r_end) of outputs [o_begin, o_end) into
+// `acc` (one accumulator per output)
+template <typename Reducer, bool Pairwise, std::size_t Rank>
+void reduce_block(const typename Reducer::value_type *in,
+                  const ReductionLayout<Rank> &layout, std::size_t r_begin,
+                  std::size_t r_end, std::size_t o_begin, std::size_t o_end,
+                  typename Reducer::accumulator_type *acc) {
+  using Acc = typename Reducer::accumulator_type;
+  const auto inner = layout.inner;
+
+  if (layout.inner_reduced) {
+    for (auto o = o_begin; o < o_end; ++o) {
+      acc[o] = fold_reduced<Reducer, Pairwise>(in, layout, layout.kept.offset(o),
+                                               r_begin, r_end);
+    }
+    return;
+  }
+
+  // Outputs come in whole rows of `inner` contiguous elements
+  const auto row_begin = o_begin / inner;
+  const auto rows = (o_end / inner) - row_begin;
+
+  auto row_offsets = std::make_unique<std::size_t[]>(rows);
+  for (std::size_t row = 0; row < rows; ++row) {
+    row_offsets[row] = layout.kept.offset((row_begin + row) * inner);
+  }
+
+  std::size_t levels = 0;
+  if constexpr (Pairwise) {
+    for (auto n = r_end - r_begin; n > pairwise_leaf<Acc>; n -= n / 2) {
+      ++levels;
+    }
+  }
+  auto scratch = std::make_unique<Acc[]>(levels * (o_end - o_begin));
+
+  fold_rows<Reducer, Pairwise>(in, layout, row_offsets.get(), rows, r_begin,
+                               r_end, acc + o_begin, scratch.get());
+}
+
+// Reduces the row-major `in` with extents `shape` over the axes set in
+// `reduce_mask`; `out` receives the kept axes in order. Reduced indices are
+// cut into fixed blocks and outputs into tiles of about a block's worth of
+// work; the tiles of every block run as independent tasks under the policy.
+// Reducing over an empty extent gives every output the reduction of no
+// elements, finalize(init(), 0), as dot() does.
+template <typename Reducer, bool Pairwise = false, std::size_t Rank,
+          typename Policy>
+void reduce(Policy &&policy, const typename Reducer::value_type *in,
+            const std::array<std::size_t, Rank> &shape,
+            const std::array<bool, Rank> &reduce_mask,
+            typename Reducer::result_type *out) {
+  using Acc = typename Reducer::accumulator_type;
+
+  const auto layout = ReductionLayout<Rank>(shape, reduce_mask);
+  const auto out_count = layout.kept.count;
+  const auto reduced_count = layout.reduced.count;
+  if (out_count == 0) {
+    return;
+  }
+  if (reduced_count == 0) {
+    std::fill_n(out, out_count, Reducer::finalize(Reducer::init(), 0));
+    return;
+  }
+
+  const auto blocks = (reduced_count + reduction_block - 1) / reduction_block;
+  const auto block_length = std::min(reduced_count, reduction_block);
+  auto tile = std::max<std::size_t>(reduction_block / block_length, 1);
+  if (not layout.inner_reduced) {
+    tile = ((tile + layout.inner - 1) / layout.inner) * layout.inner;
+  }
+  const auto tiles = (out_count + tile - 1) / tile;
+
+  // Not a std::vector: accumulators may be bool
+  auto partials = std::make_unique<Acc[]>(blocks * out_count);
+
+  execution::for_each_chunk(
+      policy, blocks * tiles,
+      [&](std::size_t task_begin, std::size_t task_end) {
+        for (auto task = task_begin; task < task_end; ++task) {
+          const auto block = task / tiles;
+          const auto o_begin = (task % tiles) * tile;
+          reduce_block<Reducer, Pairwise>(
+              in, layout, block * reduction_block,
+              std::min(reduced_count, (block + 1) * reduction_block), o_begin,
+              std::min(out_count, o_begin + tile),
+              partials.get() + (block * out_count));
+        }
+      },
+      1);
+
+  execution::for_each_chunk(
+      policy, out_count,
+      [&](std::size_t begin, std::size_t end) {
+        tree_combine<Reducer>(partials.get(), blocks, out_count, begin, end);
+        for (auto o = begin; o < end; ++o) {
+          out[o] = Reducer::finalize(partials[o], reduced_count);
+        }
+      },
+      reduction_block);
+}
+
+// sum_i a[i] * b[i], blocked and combined like reduce(). The Reducer sums
+// the products, e.g. SumReducer<Acc> or Compensated<SumReducer<Acc>>.
+template <typename Reducer, bool Pairwise = false, typename T1, typename T2,
+          typename Policy>
+auto dot(Policy &&policy, const T1 *a, const T2 *b, std::size_t count) ->
+    typename Reducer::result_type {
+  using Value = typename Reducer::value_type;
+  using Acc = typename Reducer::accumulator_type;
+
+  const auto blocks =
+      std::max<std::size_t>((count + reduction_block - 1) / reduction_block, 1);
+  auto partials = std::make_unique<Acc[]>(blocks);
+
+  const auto product = [a, b](std::size_t i) {
+    return static_cast<Value>(a[i]) * static_cast<Value>(b[i]);
+  };
+
+  execution::for_each_chunk(
+      policy, blocks,
+      [&](std::size_t block_begin, std::size_t block_end) {
+        for (auto block = block_begin; block < block_end; ++block) {
+          const auto begin = block * reduction_block;
+          partials[block] = fold_lanes<Reducer, Pairwise>(
+              begin, std::min(count, begin + reduction_block), product);
+        }
+      },
+      1);
+
+  tree_combine<Reducer>(partials.get(), blocks, 1, 0, 1);
+  return Reducer::finalize(partials[0], count);
+}
+
+// Rows of `extent` elements along the selected axis, `inner` apart in the
+// input: element r of row (o, j) of a row-major [outer, extent, inner] view
+// sits at in[(o * extent + r) * inner + j]
+struct AxisView {
+  std::size_t outer = 1;
+  std::size_t extent = 1;
+  std::size_t inner = 1;
+
+  [[nodiscard]] auto rows() const -> std::size_t { return outer * inner; }
+};
+
+} // namespace venus::kernels
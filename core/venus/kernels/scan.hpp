@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <venus/kernels/reduce.hpp>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// Inclusive scan of a contiguous run, handing emit(i, prefix) the running
+// accumulator of in[0..i] and returning the total. Four elements at a time
+// have their prefixes formed in registers, off the dependency chain that
+// carries the running value, so that chain advances once per four elements.
+template <typename Reducer, typename Emit>
+auto scan_run(const typename Reducer::value_type *in, std::size_t count,
+              const Emit &emit) -> typename Reducer::accumulator_type {
+  auto carry = Reducer::init();
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const auto p0 = Reducer::push(Reducer::init(), in[i]);
+    const auto p1 = Reducer::push(p0, in[i + 1]);
+    const auto p2 = Reducer::push(p1, in[i + 2]);
+    const auto p3 = Reducer::push(p2, in[i + 3]);
+    emit(i, Reducer::merge(carry, p0));
+    emit(i + 1, Reducer::merge(carry, p1));
+    emit(i + 2, Reducer::merge(carry, p2));
+    emit(i + 3, Reducer::merge(carry, p3));
+    carry = Reducer::merge(carry, p3);
+  }
+  for (; i < count; ++i) {
+    carry = Reducer::push(carry, in[i]);
+    emit(i, carry);
+  }
+  return carry;
+}
+
+// Inclusive scan of each row of the view with the Reducer's push and merge,
+// out[i] = finalize(in[0] (+) ... (+) in[i], i + 1), in the input's layout.
+//
+// Contiguous rows are cut into blocks of reduction_block elements, each
+// scanned from the combined total of the blocks before it. Under a parallel
+// policy long rows first scan their blocks' totals, one task per block, so
+// the blocks can then run as independent tasks. A strided
+// axis runs down one contiguous inner row at a time, vectorized across the
+// inner positions. The grouping depends on the shape alone, so any policy
+// and thread count give bitwise identical results.
+template <typename Reducer, typename Policy>
+void scan(Policy &&policy, const typename Reducer::value_type *in,
+          const AxisView &view, typename Reducer::result_type *out) {
+  using Acc = typename Reducer::accumulator_type;
+  const auto outer = view.outer;
+  const auto extent = view.extent;
+  const auto inner = view.inner;
+
+  if (inner == 1) {
+    const auto blocks = (extent + reduction_block - 1) / reduction_block;
+    const auto block_at = [&](std::size_t task) {
+      const auto row = task / blocks;
+      const auto begin = (task % blocks) * reduction_block;
+      return std::pair{(row * extent) + begin,
+                       std::min(extent - begin, reduction_block)};
+    };
+
+    const auto scan_block = [&](std::size_t task, Acc carry) {
+      const auto [offset, length] = block_at(task);
+      const auto first = (task % blocks) * reduction_block;
+      auto *result = out + offset;
+      return scan_run<Reducer>(in + offset, length,
+                               [&](std::size_t i, Acc prefix) {
+                                 result[i] = Reducer::finalize(
+                                     Reducer::merge(carry, prefix),
+                                     first + i + 1);
+                               });
+    };
+
+    // In order, each block's total is at hand when the next one starts, so
+    // a sequential scan (or a parallel one over whole rows) reads the input
+    // once. Both compute the same carries.
+    if (not execution::is_parallel_v<Policy> or blocks == 1) {
+      execution::for_each_chunk(
+          policy, outer,
+          [&](std::size_t begin, std::size_t end) {
+            for (auto row = begin; row < end; ++row) {
+              auto carry = Reducer::init();
+              for (std::size_t b = 0; b < blocks; ++b) {
+                carry = Reducer::merge(
+                    carry, scan_block((row * blocks) + b, carry));
+              }
+            }
+          },
+          std::max<std::size_t>(execution::default_grain / extent, 1));
+      return;
+    }
+
+    // Running value at the start of every block: the totals of the blocks
+    // before it in its row, combined in order
+    auto carries = std::make_unique<Acc[]>(outer * blocks);
+    execution::for_each_chunk(
+        policy, outer * blocks,
+        [&](std::size_t task_begin, std::size_t task_end) {
+          for (auto task = task_begin; task < task_end; ++task) {
+            const auto [offset, length] = block_at(task);
+            carries[task] = scan_run<Reducer>(in + offset, length,
+                                              [](std::size_t, Acc) {});
+          }
+        },
+        1);
+    execution::for_each_chunk(
+        policy, outer,
+        [&](std::size_t begin, std::size_t end) {
+          for (auto row = begin; row < end; ++row) {
+            auto carry = Reducer::init();
+            for (std::size_t b = 0; b < blocks; ++b) {
+              const auto total = carries[(row * blocks) + b];
+              carries[(row * blocks) + b] = carry;
+              carry = Reducer::merge(carry, total);
+            }
+          }
+        },
+        reduction_block);
+    execution::for_each_chunk(
+        policy, outer * blocks,
+        [&](std::size_t task_begin, std::size_t task_end) {
+          for (auto task = task_begin; task < task_end; ++task) {
+            scan_block(task, carries[task]);
+          }
+        },
+        1);
+    return;
+  }
+
+  // Strided axis: tasks are column tiles of one outer slab
+  const auto tile = std::min(inner, reduction_block);
+  const auto tiles = (inner + tile - 1) / tile;
+  execution::for_each_chunk(
+      policy, outer * tiles,
+      [&](std::size_t task_begin, std::size_t task_end) {
+        auto acc = std::make_unique<Acc[]>(tile);
+        for (auto task = task_begin; task < task_end; ++task) {
+          const auto o = task / tiles;
+          const auto j_begin = (task % tiles) * tile;
+          const auto width = std::min(inner - j_begin, tile);
+          const auto first = (o * extent * inner) + j_begin;
+          for (std::size_t j = 0; j < width; ++j) {
+            acc[j] = Reducer::init();
+          }
+          for (std::size_t r = 0; r < extent; ++r) {
+            const auto *row = in + first + (r * inner);
+            auto *result = out + first + (r * inner);
+            for (std::size_t j = 0; j < width; ++j) {
+              acc[j] = Reducer::push(acc[j], row[j]);
+              result[j] = Reducer::finalize(acc[j], r + 1);
+            }
+          }
+        }
+      },
+      std::max<std::size_t>(reduction_block / (extent * tile), 1));
+}
+
+} // namespace venus::kernels
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <venus/kernels/reduce.hpp>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// Most pieces an unsorted segment reduction is cut into. The pieces depend
+// on the shape alone, so results do not depend on the thread count.
+inline constexpr std::size_t max_segment_pieces = 64;
+
+// Reduces the rows of the view into segments: out[o, s, j] combines
+// in[o, r, j] over the rows r with ids[r] == s, in row order, and is
+// finalized with the number of such rows (an empty segment gives
+// finalize(init(), 1): 0 for sums and means, and for max -infinity on
+// floating types or the lowest value on integer ones).
+// `out` is laid out as [outer, segments, inner]; every id is below
+// `segments`.
+//
+// Sorted ids make every segment a contiguous run of rows, reduced as one
+// task. Unsorted ids are accumulated per piece of rows into private
+// partials that are merged in piece order, no atomics involved, as long as
+// the partials are no larger than the input. With more segments than that
+// the rows are grouped by segment with a stable counting sort and reduced
+// like sorted ones.
+template <typename Reducer, typename Policy>
+void segment_reduce(Policy &&policy, const typename Reducer::value_type *in,
+                    const AxisView &view, const std::size_t *ids,
+                    std::size_t segments, typename Reducer::result_type *out) {
+  using Acc = typename Reducer::accumulator_type;
+  const auto outer = view.outer;
+  const auto rows = view.extent;
+  const auto inner = view.inner;
+
+  // Rows per segment, whose prefix sums are where every segment starts in
+  // id order
+  auto starts = std::make_unique<std::size_t[]>(segments + 1);
+  for (std::size_t r = 0; r < rows; ++r) {
+    ++starts[ids[r] + 1];
+  }
+  for (std::size_t s = 0; s < segments; ++s) {
+    starts[s + 1] += starts[s];
+  }
+  const auto count_of = [&](std::size_t s) {
+    return std::max<std::size_t>(starts[s + 1] - starts[s], 1);
+  };
+
+  const bool sorted = std::is_sorted(ids, ids + rows);
+  const auto pieces = std::clamp<std::size_t>(
+      (outer * rows * inner) / execution::default_grain, 1, max_segment_pieces);
+
+  if (not sorted and pieces * segments <= rows) {
+    const auto span = outer * segments * inner;
+    auto partials = std::make_unique<Acc[]>(pieces * span);
+    execution::for_each_chunk(
+        policy, pieces,
+        [&](std::size_t piece_begin, std::size_t piece_end) {
+          for (auto piece = piece_begin; piece < piece_end; ++piece) {
+            auto *partial = partials.get() + (piece * span);
+            std::fill(partial, partial + span, Reducer::init());
+            const auto end = ((piece + 1) * rows) / pieces;
+            for (std::size_t o = 0; o < outer; ++o) {
+              for (auto r = (piece * rows) / pieces; r < end; ++r) {
+                const auto *row = in + (((o * rows) + r) * inner);
+                auto *acc = partial + (((o * segments) + ids[r]) * inner);
+                for (std::size_t j = 0; j < inner; ++j) {
+                  acc[j] = Reducer::push(acc[j], row[j]);
+                }
+              }
+            }
+          }
+        },
+        1);
+
+    execution::for_each_chunk(
+        policy, span, [&](std::size_t begin, std::size_t end) {
+          for (auto k = begin; k < end; ++k) {
+            auto acc = partials[k];
+            for (std::size_t piece = 1; piece < pieces; ++piece) {
+              acc = Reducer::merge(acc, partials[(piece * span) + k]);
+            }
+            out[k] = Reducer::finalize(acc, count_of((k / inner) % segments));
+          }
+        });
+    return;
+  }
+
+  // Rows in segment order; stable, so every segment keeps its row order
+  std::unique_ptr<std::size_t[]> order;
+  if (not sorted) {
+    order = std::make_unique<std::size_t[]>(rows);
+    auto next = std::make_unique<std::size_t[]>(segments);
+    std::copy(starts.get(), starts.get() + segments, next.get());
+    for (std::size_t r = 0; r < rows; ++r) {
+      order[next[ids[r]]++] = r;
+    }
+  }
+
+  execution::for_each_chunk(
+      policy, outer * segments,
+      [&](std::size_t task_begin, std::size_t task_end) {
+        auto acc = std::make_unique<Acc[]>(inner);
+        for (auto task = task_begin; task < task_end; ++task) {
+          const auto o = task / segments;
+          const auto s = task % segments;
+          std::fill(acc.get(), acc.get() + inner, Reducer::init());
+          for (auto k = starts[s]; k < starts[s + 1]; ++k) {
+            const auto r = order ? order[k] : k;
+            const auto *row = in + (((o * rows) + r) * inner);
+            for (std::size_t j = 0; j < inner; ++j) {
+              acc[j] = Reducer::push(acc[j], row[j]);
+            }
+          }
+          auto *result = out + (task * inner);
+          for (std::size_t j = 0; j < inner; ++j) {
+            result[j] = Reducer::finalize(acc[j], count_of(s));
+          }
+        }
+      },
+      std::max<std::size_t>((execution::default_grain * segments) /
+                                std::max<std::size_t>(rows * inner, 1),
+                            1));
+}
+
+} // namespace venus::kernels
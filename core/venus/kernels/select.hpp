@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <venus/float16.hpp>
+#include <venus/kernels/reduce.hpp>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// Orders for selecting along an axis. NaN comes before every number in both,
+// as in NumPy, so a NaN is reported rather than silently skipped.
+struct Greater {
+  template <typename T>
+  static constexpr auto before(T lhs, T rhs) -> bool {
+    return lhs > rhs or (lhs != lhs and rhs == rhs);
+  }
+};
+
+struct Less {
+  template <typename T>
+  static constexpr auto before(T lhs, T rhs) -> bool {
+    return lhs < rhs or (lhs != lhs and rhs == rhs);
+  }
+};
+
+// First position of the selected value in a contiguous row, scanned with
+// independent lanes; equal candidates of different lanes resolve to the
+// lower index
+template <typename Order, typename T>
+auto arg_select_contiguous(const T *in, std::size_t extent)
+    -> std::pair<accumulator_t<T>, std::size_t> {
+  using V = accumulator_t<T>;
+  constexpr auto L = accumulator_lanes<V>;
+
+  auto best = static_cast<V>(in[0]);
+  std::size_t at = 0;
+  std::size_t i = 1;
+
+  if (extent >= 2 * L) {
+    std::array<V, L> lane_best;
+    std::array<std::size_t, L> lane_at;
+    for (std::size_t l = 0; l < L; ++l) {
+      lane_best[l] = static_cast<V>(in[l]);
+      lane_at[l] = l;
+    }
+    for (i = L; i + L <= extent; i += L) {
+      for (std::size_t l = 0; l < L; ++l) {
+        const auto value = static_cast<V>(in[i + l]);
+        const bool take = Order::before(value, lane_best[l]);
+        lane_best[l] = take ? value : lane_best[l];
+        lane_at[l] = take ? i + l : lane_at[l];
+      }
+    }
+
+    best = lane_best[0];
+    at = lane_at[0];
+    for (std::size_t l = 1; l < L; ++l) {
+      if (Order::before(lane_best[l], best) or
+          (not Order::before(best, lane_best[l]) and lane_at[l] < at)) {
+        best = lane_best[l];
+        at = lane_at[l];
+      }
+    }
+  }
+
+  for (; i < extent; ++i) {
+    const auto value = static_cast<V>(in[i]);
+    if (Order::before(value, best)) {
+      best = value;
+      at = i;
+    }
+  }
+  return {best, at};
+}
+
+// Position (and value, unless `values` is null) of the first element of each
+// row that no other element of the row comes before. Outputs are laid out as
+// [outer, inner]; rows are split across threads under the policy.
+template <typename Order, typename T, typename Policy>
+void arg_select(Policy &&policy, const T *in, const AxisView &view, T *values,
+                std::size_t *indices) {
+  using V = accumulator_t<T>;
+  const auto outer = view.outer;
+  const auto extent = view.extent;
+  const auto inner = view.inner;
+
+  if (inner == 1) {
+    execution::for_each_chunk(
+        policy, outer,
+        [&](std::size_t begin, std::size_t end) {
+          for (auto o = begin; o < end; ++o) {
+            const auto [best, at] =
+                arg_select_contiguous<Order>(in + (o * extent), extent);
+            indices[o] = at;
+            if (values != nullptr) {
+              values[o] = static_cast<T>(best);
+            }
+          }
+        },
+        std::max<std::size_t>(execution::default_grain / extent, 1));
+    return;
+  }
+
+  // Strided axis: the scan runs down the axis, one contiguous inner row at a
+  // time, so the comparisons vectorize across the inner positions
+  execution::for_each_chunk(
+      policy, outer,
+      [&](std::size_t begin, std::size_t end) {
+        auto best = std::make_unique<V[]>(inner);
+        for (auto o = begin; o < end; ++o) {
+          const auto *slab = in + (o * extent * inner);
+          auto *at = indices + (o * inner);
+          for (std::size_t j = 0; j < inner; ++j) {
+            best[j] = static_cast<V>(slab[j]);
+            at[j] = 0;
+          }
+          for (std::size_t r = 1; r < extent; ++r) {
+            const auto *row = slab + (r * inner);
+            for (std::size_t j = 0; j < inner; ++j) {
+              const auto value = static_cast<V>(row[j]);
+              const bool take = Order::before(value, best[j]);
+              best[j] = take ? value : best[j];
+              at[j] = take ? r : at[j];
+            }
+          }
+          if (values != nullptr) {
+            for (std::size_t j = 0; j < inner; ++j) {
+              values[(o * inner) + j] = static_cast<T>(best[j]);
+            }
+          }
+        }
+      },
+      std::max<std::size_t>(execution::default_grain / (extent * inner), 1));
+}
+
+// The k first elements of each row in Order, ties by position. Each row is
+// gathered once, partially selected with nth_element and only the selected
+// k sorted, so the cost is O(extent + k log k) per row. Outputs are laid out
+// as [outer, k, inner].
+template <typename Order, typename T, typename Policy>
+void top_k(Policy &&policy, const T *in, const AxisView &view, std::size_t k,
+           T *values, std::size_t *indices) {
+  using V = accumulator_t<T>;
+  const auto extent = view.extent;
+  const auto inner = view.inner;
+
+  execution::for_each_chunk(
+      policy, view.rows(),
+      [&](std::size_t begin, std::size_t end) {
+        auto row = std::make_unique<V[]>(extent);
+        auto order = std::make_unique<std::size_t[]>(extent);
+        const auto comes_first = [&row](std::size_t lhs, std::size_t rhs) {
+          return Order::before(row[lhs], row[rhs]) or
+                 (not Order::before(row[rhs], row[lhs]) and lhs < rhs);
+        };
+
+        for (auto position = begin; position < end; ++position) {
+          const auto o = position / inner;
+          const auto j = position % inner;
+          const auto *first = in + (o * extent * inner) + j;
+          for (std::size_t r = 0; r < extent; ++r) {
+            row[r] = static_cast<V>(first[r * inner]);
+            order[r] = r;
+          }
+
+          auto *selected = order.get();
+          if (k < extent) {
+            std::nth_element(selected, selected + k, selected + extent,
+                             comes_first);
+          }
+          std::sort(selected, selected + k, comes_first);
+
+          for (std::size_t t = 0; t < k; ++t) {
+            const auto out = (((o * k) + t) * inner) + j;
+            values[out] = static_cast<T>(row[selected[t]]);
+            indices[out] = selected[t];
+          }
+        }
+      },
+      std::max<std::size_t>(execution::default_grain / extent, 1));
+}
+
+} // namespace venus::kernels
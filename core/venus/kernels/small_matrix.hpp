@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <venus/kernels/gemm.hpp>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// Matrices the batched small-matrix kernels work on at once, one per SIMD
+// lane (a full AVX-512 register of floats)
+inline constexpr std::size_t small_matrix_lanes = 16;
+
+// Largest size the batched small-matrix kernels are specialized for
+inline constexpr std::size_t max_small_matrix = 4;
+
+namespace detail {
+
+// A group of D x D matrices in structure-of-arrays order: element (i, j) of
+// every lane is contiguous, so every step below is a loop over lanes that
+// vectorizes with each lane a different matrix, whatever D is
+template <std::size_t D, typename T> struct SoaMatrices {
+  T m[D][D][small_matrix_lanes];
+};
+
+template <std::size_t D, typename T> struct SoaVectors {
+  T v[D][small_matrix_lanes];
+};
+
+// Gathers matrices [first, first + n) of a batch, matrix b being view(b).
+// Lanes past n get the identity, so that their inverses stay finite.
+template <std::size_t D, typename T, typename View>
+void gather(SoaMatrices<D, T> &out, std::size_t first, std::size_t n,
+            View &&view) {
+  for (std::size_t l = 0; l < small_matrix_lanes; ++l) {
+    if (l < n) {
+      const auto matrix = view(first + l);
+      for (std::size_t i = 0; i < D; ++i) {
+        for (std::size_t j = 0; j < D; ++j) {
+          out.m[i][j][l] = static_cast<T>(matrix(i, j));
+        }
+      }
+    } else {
+      for (std::size_t i = 0; i < D; ++i) {
+        for (std::size_t j = 0; j < D; ++j) {
+          out.m[i][j][l] = i == j ? T{1} : T{};
+        }
+      }
+    }
+  }
+}
+
+// Scatters the first n lanes back to contiguous D x D matrices
+template <std::size_t D, typename T, typename Out>
+void scatter(const SoaMatrices<D, T> &in, std::size_t n, Out *out) {
+  for (std::size_t l = 0; l < n; ++l) {
+    for (std::size_t i = 0; i < D; ++i) {
+      for (std::size_t j = 0; j < D; ++j) {
+        out[(((l * D) + i) * D) + j] = static_cast<Out>(in.m[i][j][l]);
+      }
+    }
+  }
+}
+
+template <std::size_t D, typename T>
+void soa_matmul(const SoaMatrices<D, T> &a, const SoaMatrices<D, T> &b,
+                SoaMatrices<D, T> &c) {
+  for (std::size_t i = 0; i < D; ++i) {
+    for (std::size_t j = 0; j < D; ++j) {
+      T acc[small_matrix_lanes]{};
+      for (std::size_t k = 0; k < D; ++k) {
+        for (std::size_t l = 0; l < small_matrix_lanes; ++l) {
+          acc[l] += a.m[i][k][l] * b.m[k][j][l];
+        }
+      }
+      std::copy(acc, acc + small_matrix_lanes, c.m[i][j]);
+    }
+  }
+}
+
+// Determinants by cofactor expansion; for 4 x 4, from the 2 x 2 minors of
+// the top two rows (s) and the bottom two (c)
+template <std::size_t D, typename T>
+void soa_det(const SoaMatrices<D, T> &a, T (&det)[small_matrix_lanes]) {
+  const auto &m = a.m;
+  for (std::size_t l = 0; l < small_matrix_lanes; ++l) {
+    if constexpr (D == 1) {
+      det[l] = m[0][0][l];
+    } else if constexpr (D == 2) {
+      det[l] = (m[0][0][l] * m[1][1][l]) - (m[0][1][l] * m[1][0][l]);
+    } else if constexpr (D == 3) {
+      det[l] = (m[0][0][l] * ((m[1][1][l] * m[2][2][l]) -
+                              (m[1][2][l] * m[2][1][l]))) +
+               (m[0][1][l] * ((m[1][2][l] * m[2][0][l]) -
+                              (m[1][0][l] * m[2][2][l]))) +
+               (m[0][2][l] * ((m[1][0][l] * m[2][1][l]) -
+                              (m[1][1][l] * m[2][0][l])));
+    } else {
+      const T s0 = (m[0][0][l] * m[1][1][l]) - (m[1][0][l] * m[0][1][l]);
+      const T s1 = (m[0][0][l] * m[1][2][l]) - (m[1][0][l] * m[0][2][l]);
+      const T s2 = (m[0][0][l] * m[1][3][l]) - (m[1][0][l] * m[0][3][l]);
+      const T s3 = (m[0][1][l] * m[1][2][l]) - (m[1][1][l] * m[0][2][l]);
+      const T s4 = (m[0][1][l] * m[1][3][l]) - (m[1][1][l] * m[0][3][l]);
+      const T s5 = (m[0][2][l] * m[1][3][l]) - (m[1][2][l] * m[0][3][l]);
+      const T c5 = (m[2][2][l] * m[3][3][l]) - (m[3][2][l] * m[2][3][l]);
+      const T c4 = (m[2][1][l] * m[3][3][l]) - (m[3][1][l] * m[2][3][l]);
+      const T c3 = (m[2][1][l] * m[3][2][l]) - (m[3][1][l] * m[2][2][l]);
+      const T c2 = (m[2][0][l] * m[3][3][l]) - (m[3][0][l] * m[2][3][l]);
+      const T c1 = (m[2][0][l] * m[3][2][l]) - (m[3][0][l] * m[2][2][l]);
+      const T c0 = (m[2][0][l] * m[3][1][l]) - (m[3][0][l] * m[2][1][l]);
+      det[l] = (s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) +
+               (s5 * c0);
+    }
+  }
+}
+
+// Inverses as the adjugate over the determinant. Singular matrices give
+// infinities or NaNs, as a division by their zero determinant would.
+template <std::size_t D, typename T>
+void soa_inverse(const SoaMatrices<D, T> &a, SoaMatrices<D, T> &b) {
+  const auto &m = a.m;
+  auto &r = b.m;
+  for (std::size_t l = 0; l < small_matrix_lanes; ++l) {
+    if constexpr (D == 1) {
+      r[0][0][l] = T{1} / m[0][0][l];
+    } else if constexpr (D == 2) {
+      const T inv =
+          T{1} / ((m[0][0][l] * m[1][1][l]) - (m[0][1][l] * m[1][0][l]));
+      r[0][0][l] = m[1][1][l] * inv;
+      r[0][1][l] = -m[0][1][l] * inv;
+      r[1][0][l] = -m[1][0][l] * inv;
+      r[1][1][l] = m[0][0][l] * inv;
+    } else if constexpr (D == 3) {
+      const T c00 = (m[1][1][l] * m[2][2][l]) - (m[1][2][l] * m[2][1][l]);
+      const T c01 = (m[1][2][l] * m[2][0][l]) - (m[1][0][l] * m[2][2][l]);
+      const T c02 = (m[1][0][l] * m[2][1][l]) - (m[1][1][l] * m[2][0][l]);
+      const T inv = T{1} / ((m[0][0][l] * c00) + (m[0][1][l] * c01) +
+                            (m[0][2][l] * c02));
+      r[0][0][l] = c00 * inv;
+      r[1][0][l] = c01 * inv;
+      r[2][0][l] = c02 * inv;
+      r[0][1][l] =
+          ((m[0][2][l] * m[2][1][l]) - (m[0][1][l] * m[2][2][l])) * inv;
+      r[1][1][l] =
+          ((m[0][0][l] * m[2][2][l]) - (m[0][2][l] * m[2][0][l])) * inv;
+      r[2][1][l] =
+          ((m[0][1][l] * m[2][0][l]) - (m[0][0][l] * m[2][1][l])) * inv;
+      r[0][2][l] =
+          ((m[0][1][l] * m[1][2][l]) - (m[0][2][l] * m[1][1][l])) * inv;
+      r[1][2][l] =
+          ((m[0][2][l] * m[1][0][l]) - (m[0][0][l] * m[1][2][l])) * inv;
+      r[2][2][l] =
+          ((m[0][0][l] * m[1][1][l]) - (m[0][1][l] * m[1][0][l])) * inv;
+    } else {
+      const T s0 = (m[0][0][l] * m[1][1][l]) - (m[1][0][l] * m[0][1][l]);
+      const T s1 = (m[0][0][l] * m[1][2][l]) - (m[1][0][l] * m[0][2][l]);
+      const T s2 = (m[0][0][l] * m[1][3][l]) - (m[1][0][l] * m[0][3][l]);
+      const T s3 = (m[0][1][l] * m[1][2][l]) - (m[1][1][l] * m[0][2][l]);
+      const T s4 = (m[0][1][l] * m[1][3][l]) - (m[1][1][l] * m[0][3][l]);
+      const T s5 = (m[0][2][l] * m[1][3][l]) - (m[1][2][l] * m[0][3][l]);
+      const T c5 = (m[2][2][l] * m[3][3][l]) - (m[3][2][l] * m[2][3][l]);
+      const T c4 = (m[2][1][l] * m[3][3][l]) - (m[3][1][l] * m[2][3][l]);
+      const T c3 = (m[2][1][l] * m[3][2][l]) - (m[3][1][l] * m[2][2][l]);
+      const T c2 = (m[2][0][l] * m[3][3][l]) - (m[3][0][l] * m[2][3][l]);
+      const T c1 = (m[2][0][l] * m[3][2][l]) - (m[3][0][l] * m[2][2][l]);
+      const T c0 = (m[2][0][l] * m[3][1][l]) - (m[3][0][l] * m[2][1][l]);
+      const T inv = T{1} / ((s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) -
+                            (s4 * c1) + (s5 * c0));
+      r[0][0][l] =
+          ((m[1][1][l] * c5) - (m[1][2][l] * c4) + (m[1][3][l] * c3)) * inv;
+      r[0][1][l] =
+          (-(m[0][1][l] * c5) + (m[0][2][l] * c4) - (m[0][3][l] * c3)) * inv;
+      r[0][2][l] =
+          ((m[3][1][l] * s5) - (m[3][2][l] * s4) + (m[3][3][l] * s3)) * inv;
+      r[0][3][l] =
+          (-(m[2][1][l] * s5) + (m[2][2][l] * s4) - (m[2][3][l] * s3)) * inv;
+      r[1][0][l] =
+          (-(m[1][0][l] * c5) + (m[1][2][l] * c2) - (m[1][3][l] * c1)) * inv;
+      r[1][1][l] =
+          ((m[0][0][l] * c5) - (m[0][2][l] * c2) + (m[0][3][l] * c1)) * inv;
+      r[1][2][l] =
+          (-(m[3][0][l] * s5) + (m[3][2][l] * s2) - (m[3][3][l] * s1)) * inv;
+      r[1][3][l] =
+          ((m[2][0][l] * s5) - (m[2][2][l] * s2) + (m[2][3][l] * s1)) * inv;
+      r[2][0][l] =
+          ((m[1][0][l] * c4) - (m[1][1][l] * c2) + (m[1][3][l] * c0)) * inv;
+      r[2][1][l] =
+          (-(m[0][0][l] * c4) + (m[0][1][l] * c2) - (m[0][3][l] * c0)) * inv;
+      r[2][2][l] =
+          ((m[3][0][l] * s4) - (m[3][1][l] * s2) + (m[3][3][l] * s0)) * inv;
+      r[2][3][l] =
+          (-(m[2][0][l] * s4) + (m[2][1][l] * s2) - (m[2][3][l] * s0)) * inv;
+      r[3][0][l] =
+          (-(m[1][0][l] * c3) + (m[1][1][l] * c1) - (m[1][2][l] * c0)) * inv;
+      r[3][1][l] =
+          ((m[0][0][l] * c3) - (m[0][1][l] * c1) + (m[0][2][l] * c0)) * inv;
+      r[3][2][l] =
+          (-(m[3][0][l] * s3) + (m[3][1][l] * s1) - (m[3][2][l] * s0)) * inv;
+      r[3][3][l] =
+          ((m[2][0][l] * s3) - (m[2][1][l] * s1) + (m[2][2][l] * s0)) * inv;
+    }
+  }
+}
+
+// Runs fn(first, n) over the groups of small_matrix_lanes matrices of a
+// batch, n being short only for the last group
+template <typename Policy, typename Fn>
+void for_each_small_group(Policy &&policy, std::size_t batch,
+                          std::size_t work_per_matrix, Fn &&fn) {
+  constexpr auto lanes = small_matrix_lanes;
+  const auto groups = (batch + lanes - 1) / lanes;
+  execution::for_each_chunk(
+      policy, groups,
+      [&](std::size_t group_begin, std::size_t group_end) {
+        for (auto group = group_begin; group < group_end; ++group) {
+          fn(group * lanes, std::min(lanes, batch - (group * lanes)));
+        }
+      },
+      std::max<std::size_t>(
+          execution::default_grain / (lanes * work_per_matrix), 1));
+}
+
+} // namespace detail
+
+// Calls fn(std::integral_constant<std::size_t, D>{}) for the runtime size d,
+// so that the kernels below are picked per size; false when d is larger
+// than max_small_matrix
+template <typename Fn>
+auto dispatch_small_matrix(std::size_t d, Fn &&fn) -> bool {
+  return [&]<std::size_t... D>(std::index_sequence<D...>) {
+    return ((d == D + 1 and
+             (fn(std::integral_constant<std::size_t, D + 1>{}), true)) or
+            ...);
+  }(std::make_index_sequence<max_small_matrix>{});
+}
+
+// C_b = A_b B_b for a batch of D x D matrices, A_b being a(b) and B_b b(b)
+// (MatrixViews, so transposed and broadcast operands are read in place),
+// into contiguous C, computed in T
+template <std::size_t D, typename T, typename Policy, typename ViewA,
+          typename ViewB>
+void small_matmul(Policy &&policy, std::size_t batch, ViewA &&a, ViewB &&b,
+                  T *c) {
+  detail::for_each_small_group(
+      policy, batch, D * D * D, [&](std::size_t first, std::size_t n) {
+        detail::SoaMatrices<D, T> lhs;
+        detail::SoaMatrices<D, T> rhs;
+        detail::SoaMatrices<D, T> product;
+        detail::gather(lhs, first, n, a);
+        detail::gather(rhs, first, n, b);
+        detail::soa_matmul(lhs, rhs, product);
+        detail::scatter(product, n, c + (first * D * D));
+      });
+}
+
+// Determinants of a batch of contiguous D x D matrices, computed in T
+template <std::size_t D, typename T, typename TA, typename Out,
+          typename Policy>
+void small_det(Policy &&policy, std::size_t batch, const TA *a, Out *out) {
+  detail::for_each_small_group(
+      policy, batch, D * D * D, [&](std::size_t first, std::size_t n) {
+        detail::SoaMatrices<D, T> matrices;
+        T det[small_matrix_lanes];
+        detail::gather(matrices, first, n, [&](std::size_t m) {
+          return MatrixView<TA>{a + (m * D * D), D, 1};
+        });
+        detail::soa_det(matrices, det);
+        for (std::size_t l = 0; l < n; ++l) {
+          out[first + l] = static_cast<Out>(det[l]);
+        }
+      });
+}
+
+// Inverses of a batch of contiguous D x D matrices, computed in T
+template <std::size_t D, typename T, typename TA, typename Out,
+          typename Policy>
+void small_inverse(Policy &&policy, std::size_t batch, const TA *a,
+                   Out *out) {
+  detail::for_each_small_group(
+      policy, batch, D * D * D, [&](std::size_t first, std::size_t n) {
+        detail::SoaMatrices<D, T> matrices;
+        detail::SoaMatrices<D, T> inverses;
+        detail::gather(matrices, first, n, [&](std::size_t m) {
+          return MatrixView<TA>{a + (m * D * D), D, 1};
+        });
+        detail::soa_inverse(matrices, inverses);
+        detail::scatter(inverses, n, out + (first * D * D));
+      });
+}
+
+// y_b = M_b x_b for a batch of contiguous D x D matrices (a single one
+// shared by all the vectors when matrix_stride is 0) and contiguous vectors
+// of V components, computed in T. With V = D - 1 the vectors are points in
+// homogeneous coordinates: a 1 is appended, and the result is divided by
+// its last component, which is dropped.
+template <std::size_t D, std::size_t V, typename T, typename TM, typename TV,
+          typename Out, typename Policy>
+  requires(V == D or V + 1 == D)
+void small_transform(Policy &&policy, std::size_t batch, const TM *m,
+                     std::size_t matrix_stride, const TV *x, Out *y) {
+  detail::for_each_small_group(
+      policy, batch, D * D, [&](std::size_t first, std::size_t n) {
+        detail::SoaMatrices<D, T> matrices;
+        detail::SoaVectors<D, T> in;
+        detail::SoaVectors<D, T> out;
+        detail::gather(matrices, first, n, [&](std::size_t b) {
+          return MatrixView<TM>{m + (b * matrix_stride), D, 1};
+        });
+        for (std::size_t l = 0; l < small_matrix_lanes; ++l) {
+          for (std::size_t i = 0; i < D; ++i) {
+            in.v[i][l] = l < n and i < V
+                             ? static_cast<T>(x[((first + l) * V) + i])
+                             : T{1};
+          }
+        }
+
+        for (std::size_t i = 0; i < D; ++i) {
+          for (std::size_t l = 0; l < small_matrix_lanes; ++l) {
+            out.v[i][l] = T{};
+          }
+          for (std::size_t k = 0; k < D; ++k) {
+            for (std::size_t l = 0; l < small_matrix_lanes; ++l) {
+              out.v[i][l] += matrices.m[i][k][l] * in.v[k][l];
+            }
+          }
+        }
+        if constexpr (V + 1 == D) {
+          for (std::size_t i = 0; i < V; ++i) {
+            for (std::size_t l = 0; l < small_matrix_lanes; ++l) {
+              out.v[i][l] /= out.v[V][l];
+            }
+          }
+        }
+
+        for (std::size_t l = 0; l < n; ++l) {
+          for (std::size_t i = 0; i < V; ++i) {
+            y[((first + l) * V) + i] = static_cast<Out>(out.v[i][l]);
+          }
+        }
+      });
+}
+
+} // namespace venus::kernels
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <venus/float16.hpp>
+#include <venus/kernels/math.hpp>
+#include <venus/kernels/reduce.hpp>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// Running maximum and sum of exp(x - maximum) over a row
+template <typename V> struct SoftmaxStats {
+  V max = -std::numeric_limits<V>::infinity();
+  V sum = 0;
+};
+
+// Max and exp-sum of a contiguous row in a single read (online softmax): the
+// row goes by chunks, each chunk's max found with independent lanes, and the
+// sum so far rescaled by exp(old - new) only when the max grows
+template <typename T>
+auto softmax_stats(const T *in, std::size_t extent)
+    -> SoftmaxStats<accumulator_t<T>> {
+  using V = accumulator_t<T>;
+  constexpr auto L = accumulator_lanes<V>;
+  constexpr auto chunk = 16 * L;
+
+  SoftmaxStats<V> stats;
+  for (std::size_t begin = 0; begin < extent; begin += chunk) {
+    const auto end = std::min(extent, begin + chunk);
+
+    std::array<V, L> lane_max;
+    lane_max.fill(stats.max);
+    std::size_t i = begin;
+    for (; i + L <= end; i += L) {
+      for (std::size_t l = 0; l < L; ++l) {
+        const auto value = static_cast<V>(in[i + l]);
+        lane_max[l] = value > lane_max[l] ? value : lane_max[l];
+      }
+    }
+    auto max = *std::ranges::max_element(lane_max);
+    for (; i < end; ++i) {
+      const auto value = static_cast<V>(in[i]);
+      max = value > max ? value : max;
+    }
+
+    // A chunk of -inf only adds zeros; skipping it keeps -inf - -inf out
+    if (max == -std::numeric_limits<V>::infinity()) {
+      continue;
+    }
+    if (max > stats.max) {
+      stats.sum *= exp_of(stats.max - max);
+      stats.max = max;
+    }
+
+    std::array<V, L> lane_sum{};
+    for (i = begin; i + L <= end; i += L) {
+      for (std::size_t l = 0; l < L; ++l) {
+        lane_sum[l] += exp_of(static_cast<V>(in[i + l]) - stats.max);
+      }
+    }
+    for (; i < end; ++i) {
+      lane_sum[0] += exp_of(static_cast<V>(in[i]) - stats.max);
+    }
+    for (auto partial : lane_sum) {
+      stats.sum += partial;
+    }
+  }
+  return stats;
+}
+
+// softmax (or log_softmax when Log) of each row of the view, written to the
+// same layout in `out`. Rows are independent, so they are split across
+// threads under the policy and the results do not depend on the split.
+template <bool Log, typename T, typename Policy>
+void softmax(Policy &&policy, const T *in, const AxisView &view, T *out) {
+  using V = accumulator_t<T>;
+  const auto outer = view.outer;
+  const auto extent = view.extent;
+  const auto inner = view.inner;
+
+  if (inner == 1) {
+    execution::for_each_chunk(
+        policy, outer,
+        [&](std::size_t begin, std::size_t end) {
+          for (auto o = begin; o < end; ++o) {
+            const auto *row = in + (o * extent);
+            auto *result = out + (o * extent);
+            const auto stats = softmax_stats(row, extent);
+            if constexpr (Log) {
+              // Subtracted one at a time: max + log(sum) would round away
+              // the low bits of log(sum) for large inputs
+              const auto log_sum = std::log(stats.sum);
+              for (std::size_t i = 0; i < extent; ++i) {
+                result[i] = static_cast<T>(
+                    (static_cast<V>(row[i]) - stats.max) - log_sum);
+              }
+            } else {
+              const auto scale = V{1} / stats.sum;
+              for (std::size_t i = 0; i < extent; ++i) {
+                result[i] = static_cast<T>(
+                    exp_of(static_cast<V>(row[i]) - stats.max) * scale);
+              }
+            }
+          }
+        },
+        std::max<std::size_t>(execution::default_grain / extent, 1));
+    return;
+  }
+
+  // Strided axis: every pass runs down the axis one contiguous inner row at
+  // a time, vectorized across the inner positions. The max gets a pass of
+  // its own, which is cheaper than the second exponential per element an
+  // online update would need here.
+  execution::for_each_chunk(
+      policy, outer,
+      [&](std::size_t begin, std::size_t end) {
+        auto max = std::make_unique<V[]>(inner);
+        auto sum = std::make_unique<V[]>(inner);
+        for (auto o = begin; o < end; ++o) {
+          const auto *slab = in + (o * extent * inner);
+          auto *result = out + (o * extent * inner);
+
+          for (std::size_t j = 0; j < inner; ++j) {
+            max[j] = static_cast<V>(slab[j]);
+            sum[j] = 0;
+          }
+          for (std::size_t r = 1; r < extent; ++r) {
+            const auto *row = slab + (r * inner);
+            for (std::size_t j = 0; j < inner; ++j) {
+              const auto value = static_cast<V>(row[j]);
+              max[j] = value > max[j] ? value : max[j];
+            }
+          }
+          for (std::size_t r = 0; r < extent; ++r) {
+            const auto *row = slab + (r * inner);
+            for (std::size_t j = 0; j < inner; ++j) {
+              sum[j] += exp_of(static_cast<V>(row[j]) - max[j]);
+            }
+          }
+
+          if constexpr (Log) {
+            for (std::size_t j = 0; j < inner; ++j) {
+              sum[j] = std::log(sum[j]);
+            }
+          } else {
+            for (std::size_t j = 0; j < inner; ++j) {
+              sum[j] = V{1} / sum[j];
+            }
+          }
+          for (std::size_t r = 0; r < extent; ++r) {
+            const auto *row = slab + (r * inner);
+            auto *target = result + (r * inner);
+            for (std::size_t j = 0; j < inner; ++j) {
+              const auto shifted = static_cast<V>(row[j]) - max[j];
+              if constexpr (Log) {
+                target[j] = static_cast<T>(shifted - sum[j]);
+              } else {
+                target[j] = static_cast<T>(exp_of(shifted) * sum[j]);
+              }
+            }
+          }
+        }
+      },
+      std::max<std::size_t>(execution::default_grain / (extent * inner), 1));
+}
+
+} // namespace venus::kernels
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <venus/kernels/cache_info.hpp>
+#include <venus/kernels/gemm.hpp>
+#include <venus/kernels/gemv.hpp>
+#include <venus/parallel/execution.hpp>
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace venus::kernels {
+
+// 2:4 structured sparsity: every group of four consecutive entries of a row
+// keeps (at most) two, stored as their two values and a 4-bit nibble with
+// their positions in the group, the first in bits 0-1 and the second in bits
+// 2-3. Two groups share a metadata byte, the even one in the low nibble.
+inline constexpr std::size_t structured_group = 4;
+inline constexpr std::size_t structured_kept = 2;
+
+// Metadata bytes of a row of K columns
+constexpr auto structured_metadata_stride(std::size_t K) -> std::size_t {
+  return ((K / structured_group) + 1) / 2;
+}
+
+namespace detail {
+
+// Columns of the two entries group g of a 2:4 row keeps
+inline auto structured_columns(const std::uint8_t *metadata, std::size_t g)
+    -> std::pair<std::size_t, std::size_t> {
+  const auto nibble = (metadata[g / 2] >> (4 * (g % 2))) & 0xF;
+  return {(g * structured_group) + (nibble & 0x3),
+          (g * structured_group) + (nibble >> 2)};
+}
+
+// Rows per chunk for a sparse pass doing `width` multiply-adds per stored
+// entry, so that each chunk gets about default_grain of them on average
+inline auto sparse_row_grain(std::size_t rows, std::size_t nnz,
+                             std::size_t width) -> std::size_t {
+  const auto per_row =
+      std::max<std::size_t>((nnz * width) / std::max<std::size_t>(rows, 1), 1);
+  return std::max<std::size_t>(execution::default_grain / per_row, 1);
+}
+
+// c[j] = sum over p in [begin, end) of values[p] B[cols[p], j] for W
+// vectors of columns from column 0: a vector-matrix product (as in gevm)
+// over only the stored entries of a row
+template <std::size_t W, typename T, typename TA>
+void spmm_strip_simd(std::size_t begin, std::size_t end,
+                     const std::size_t *cols, const TA *values, const T *b,
+                     std::size_t ldb, T *c) {
+  using Ops = SimdOps<T>;
+  constexpr auto L = Ops::lanes;
+
+  typename Ops::type acc[W];
+  unroll<W>([&](auto w) { acc[w] = Ops::zero(); });
+  for (auto p = begin; p < end; ++p) {
+    const auto av = Ops::broadcast(static_cast<T>(values[p]));
+    const auto *row = b + (cols[p] * ldb);
+    unroll<W>([&](auto w) {
+      acc[w] = Ops::fma(av, Ops::load(row + (w * L)), acc[w]);
+    });
+  }
+  unroll<W>([&](auto w) { Ops::store(c + (w * L), acc[w]); });
+}
+
+// As spmm_strip_simd for groups [g_begin, g_end) of a 2:4 row against a
+// packed panel of B whose row 0 is column 4 g_begin of A: two fused
+// multiply-adds per group instead of four, adding to c when accumulating.
+// The two entries of a group go to separate accumulators, so that twice as
+// many independent chains hide the latency of the multiply-adds.
+template <std::size_t W, typename T, typename TA>
+void spmm_2_4_strip_simd(std::size_t g_begin, std::size_t g_end,
+                         const std::uint8_t *metadata, const TA *values,
+                         const T *panel, std::size_t ldp, T *c,
+                         bool accumulate) {
+  using Ops = SimdOps<T>;
+  constexpr auto L = Ops::lanes;
+  const auto first = g_begin * structured_group;
+
+  typename Ops::type acc0[W];
+  typename Ops::type acc1[W];
+  unroll<W>([&](auto w) {
+    acc0[w] = accumulate ? Ops::load(c + (w * L)) : Ops::zero();
+    acc1[w] = Ops::zero();
+  });
+  for (auto g = g_begin; g < g_end; ++g) {
+    const auto [k0, k1] = structured_columns(metadata, g);
+    const auto a0 = Ops::broadcast(static_cast<T>(values[2 * g]));
+    const auto a1 = Ops::broadcast(static_cast<T>(values[(2 * g) + 1]));
+    const auto *row0 = panel + ((k0 - first) * ldp);
+    const auto *row1 = panel + ((k1 - first) * ldp);
+    unroll<W>([&](auto w) {
+      acc0[w] = Ops::fma(a0, Ops::load(row0 + (w * L)), acc0[w]);
+      acc1[w] = Ops::fma(a1, Ops::load(row1 + (w * L)), acc1[w]);
+    });
+  }
+  unroll<W>([&](auto w) {
+    Ops::store(c + (w * L), Ops::add(acc0[w], acc1[w]));
+  });
+}
+
+// Dot product of a 2:4 row with x (stride ldx). The two groups of every
+// metadata byte are decoded together into four independent sums.
+template <typename T, typename TA, typename TX>
+auto structured_dot(std::size_t groups, const std::uint8_t *metadata,
+                    const TA *values, const TX *x, std::size_t ldx) -> T {
+#if defined(__AVX512F__)
+  // Eight groups (32 columns of x, 16 kept entries) per step: the positions
+  // in four metadata bytes become lane indices that pick x in registers, so
+  // the values and x are both read as contiguous vectors
+  if constexpr (std::is_same_v<T, float> and std::is_same_v<TA, float> and
+                std::is_same_v<TX, float>) {
+    if (ldx == 1 and groups >= 8) {
+      const auto shifts = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18,
+                                            20, 22, 24, 26, 28, 30);
+      const auto bases = _mm512_setr_epi32(0, 0, 4, 4, 8, 8, 12, 12, 16, 16,
+                                           20, 20, 24, 24, 28, 28);
+      const auto positions = _mm512_set1_epi32(0x3);
+      __m512 acc[2] = {_mm512_setzero_ps(), _mm512_setzero_ps()};
+      std::size_t g = 0;
+      for (; g + 8 <= groups; g += 8) {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, metadata + (g / 2), sizeof(bits));
+        const auto lanes = _mm512_add_epi32(
+            bases,
+            _mm512_and_si512(
+                _mm512_srlv_epi32(
+                    _mm512_set1_epi32(static_cast<int>(bits)), shifts),
+                positions));
+        const auto *window = x + (g * structured_group);
+        const auto picked = _mm512_permutex2var_ps(
+            _mm512_loadu_ps(window), lanes, _mm512_loadu_ps(window + 16));
+        auto &sum = acc[(g / 8) % 2];
+        sum = _mm512_fmadd_ps(_mm512_loadu_ps(values + (2 * g)), picked, sum);
+      }
+      auto result = _mm512_reduce_add_ps(_mm512_add_ps(acc[0], acc[1]));
+      for (; g < groups; ++g) {
+        const auto [k0, k1] = structured_columns(metadata, g);
+        result += (values[2 * g] * x[k0]) + (values[(2 * g) + 1] * x[k1]);
+      }
+      return result;
+    }
+  }
+#endif
+  T sum[4]{};
+  std::size_t g = 0;
+  for (; g + 2 <= groups; g += 2) {
+    const auto byte = metadata[g / 2];
+    const auto *window = x + (g * structured_group * ldx);
+    const auto *v = values + (2 * g);
+    sum[0] += static_cast<T>(v[0]) * static_cast<T>(window[(byte & 0x3) * ldx]);
+    sum[1] += static_cast<T>(v[1]) *
+              static_cast<T>(window[((byte >> 2) & 0x3) * ldx]);
+    sum[2] += static_cast<T>(v[2]) *
+              static_cast<T>(window[(4 + ((byte >> 4) & 0x3)) * ldx]);
+    sum[3] += static_cast<T>(v[3]) *
+              static_cast<T>(window[(4 + (byte >> 6)) * ldx]);
+  }
+  if (g < groups) {
+    const auto [k0, k1] = structured_columns(metadata, g);
+    sum[0] += static_cast<T>(values[2 * g]) * static_cast<T>(x[k0 * ldx]);
+    sum[1] += static_cast<T>(values[(2 * g) + 1]) * static_cast<T>(x[k1 * ldx]);
+  }
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+// Columns of A per block of spmm_2_4, so that the packed panel of B one
+// block walks stays in half of L1 across a block of rows of A
+template <typename T>
+auto structured_block(std::size_t width, const CacheSizes &caches)
+    -> std::size_t {
+  const auto rows = (caches.l1d / 2) / (width * sizeof(T));
+  return std::max<std::size_t>(rows / structured_group, 1) * structured_group;
+}
+
+// Rows of A per block of spmm_2_4, so that their values and their rows of C
+// stay in half of L2 while every column block goes over them
+template <typename T, typename TA>
+auto structured_rows(std::size_t N, std::size_t K, const CacheSizes &caches)
+    -> std::size_t {
+  const auto row_bytes = ((K / 2) * sizeof(TA)) + (N * sizeof(T));
+  return std::max<std::size_t>((caches.l2 / 2) / row_bytes, 1);
+}
+
+} // namespace detail
+
+// y = A x for an M-row CSR matrix A (row_offsets of M + 1 entries into the
+// column indices and values), computed in T. Parallel policies split the
+// rows; every row is summed in storage order whatever the split.
+template <typename T, typename TA, typename TX, typename Out, typename Policy>
+void spmv(Policy &&policy, std::size_t M, const std::size_t *row_offsets,
+          const std::size_t *cols, const TA *values, const TX *x, Out *y) {
+  execution::for_each_chunk(
+      policy, M,
+      [&](std::size_t row_begin, std::size_t row_end) {
+        for (auto i = row_begin; i < row_end; ++i) {
+          T sum{};
+          for (auto p = row_offsets[i]; p < row_offsets[i + 1]; ++p) {
+            sum += static_cast<T>(values[p]) * static_cast<T>(x[cols[p]]);
+          }
+          y[i] = static_cast<Out>(sum);
+        }
+      },
+      detail::sparse_row_grain(M, row_offsets[M], 1));
+}
+
+// C = A B for an M-row CSR matrix A and a row-major B with leading dimension
+// ldb, into the row-major M x N matrix C with leading dimension ldc,
+// computed in T. Every stored A[i, k] scales row k of B into row i of C, so
+// only the stored entries cost anything and B is read row by row. Rows of C
+// are built gevm_strip SIMD vectors at a time in registers when B is
+// already T; parallel policies split the rows.
+template <typename T, typename TA, typename TB, typename Policy>
+void spmm(Policy &&policy, std::size_t M, std::size_t N,
+          const std::size_t *row_offsets, const std::size_t *cols,
+          const TA *values, const TB *b, std::size_t ldb, T *c,
+          std::size_t ldc) {
+  constexpr bool vectorized =
+      detail::SimdOps<T>::enabled and std::is_same_v<TB, T>;
+
+  execution::for_each_chunk(
+      policy, M,
+      [&](std::size_t row_begin, std::size_t row_end) {
+        for (auto i = row_begin; i < row_end; ++i) {
+          const auto begin = row_offsets[i];
+          const auto end = row_offsets[i + 1];
+          auto *c_row = c + (i * ldc);
+          std::size_t j = 0;
+          if constexpr (vectorized) {
+            constexpr auto L = detail::SimdOps<T>::lanes;
+            constexpr auto width = gevm_strip * L;
+            for (; j + width <= N; j += width) {
+              detail::spmm_strip_simd<gevm_strip>(begin, end, cols, values,
+                                                  b + j, ldb, c_row + j);
+            }
+            for (; j + L <= N; j += L) {
+              detail::spmm_strip_simd<1>(begin, end, cols, values, b + j, ldb,
+                                         c_row + j);
+            }
+          }
+          std::fill(c_row + j, c_row + N, T{});
+          for (auto p = begin; p < end; ++p) {
+            const auto a = static_cast<T>(values[p]);
+            const auto *b_row = b + (cols[p] * ldb);
+            for (auto jj = j; jj < N; ++jj) {
+              c_row[jj] += a * static_cast<T>(b_row[jj]);
+            }
+          }
+        }
+      },
+      detail::sparse_row_grain(M, row_offsets[M], N));
+}
+
+// C = A B for an M x K matrix A in 2:4 structured form (K / 2 values and
+// structured_metadata_stride(K) metadata bytes per row) and a row-major B
+// with leading dimension ldb, into the row-major M x N matrix C with
+// leading dimension ldc, computed in T. As spmm, but the stored entries sit
+// at fixed offsets and in column order, so the values stream like a dense
+// row of half the length and only the rows of B they select are read. As
+// in gemm, panels of B are packed (and converted to T) once per block of
+// rows and reused from L1 by all of them. Parallel policies split the
+// blocks of rows.
+template <typename T, typename TA, typename TB, typename Policy>
+void spmm_2_4(Policy &&policy, std::size_t M, std::size_t N, std::size_t K,
+              const TA *values, const std::uint8_t *metadata, const TB *b,
+              std::size_t ldb, T *c, std::size_t ldc) {
+  constexpr bool vectorized = detail::SimdOps<T>::enabled;
+  constexpr auto L = detail::SimdOps<T>::lanes;
+  constexpr auto width = vectorized ? gevm_strip * L : 64;
+  const auto groups = K / structured_group;
+  const auto stride = structured_metadata_stride(K);
+  const auto &caches = cache_sizes();
+  const auto block = detail::structured_block<T>(width, caches);
+  const auto rows = detail::structured_rows<T, TA>(N, K, caches);
+
+  const auto run = [&](std::size_t row_begin, std::size_t row_end) {
+    auto panel = std::make_unique<T[]>(block * width);
+    for (std::size_t k = 0; k < K; k += block) {
+      const auto k_end = std::min(k + block, K);
+      const auto g_begin = k / structured_group;
+      const auto g_end = k_end / structured_group;
+      const bool accumulate = k > 0;
+      for (std::size_t j_begin = 0; j_begin < N; j_begin += width) {
+        const auto columns = std::min(width, N - j_begin);
+        for (auto kk = k; kk < k_end; ++kk) {
+          for (std::size_t jj = 0; jj < columns; ++jj) {
+            panel[((kk - k) * width) + jj] =
+                static_cast<T>(b[(kk * ldb) + j_begin + jj]);
+          }
+        }
+
+        for (auto i = row_begin; i < row_end; ++i) {
+          const auto *row_values = values + (i * groups * structured_kept);
+          const auto *row_metadata = metadata + (i * stride);
+          auto *c_row = c + (i * ldc) + j_begin;
+          std::size_t j = 0;
+          if constexpr (vectorized) {
+            if (columns == width) {
+              detail::spmm_2_4_strip_simd<gevm_strip>(
+                  g_begin, g_end, row_metadata, row_values, panel.get(), width,
+                  c_row, accumulate);
+              continue;
+            }
+            for (; j + L <= columns; j += L) {
+              detail::spmm_2_4_strip_simd<1>(g_begin, g_end, row_metadata,
+                                             row_values, panel.get() + j,
+                                             width, c_row + j, accumulate);
+            }
+          }
+          if (not accumulate) {
+            std::fill(c_row + j, c_row + columns, T{});
+          }
+          for (auto g = g_begin; g < g_end; ++g) {
+            const auto [k0, k1] = detail::structured_columns(row_metadata, g);
+            const auto a0 = static_cast<T>(row_values[2 * g]);
+            const auto a1 = static_cast<T>(row_values[(2 * g) + 1]);
+            const auto *row0 = panel.get() + ((k0 - k) * width);
+            const auto *row1 = panel.get() + ((k1 - k) * width);
+            for (auto jj = j; jj < columns; ++jj) {
+              c_row[jj] += (a0 * row0[jj]) + (a1 * row1[jj]);
+            }
+          }
+        }
+      }
+    }
+  };
+
+  // A single column is a matrix-vector product: no panel to share
+  if (N == 1) {
+    execution::for_each_chunk(
+        policy, M,
+        [&](std::size_t row_begin, std::size_t row_end) {
+          for (auto i = row_begin; i < row_end; ++i) {
+            c[i * ldc] = detail::structured_dot<T>(
+                groups, metadata + (i * stride),
+                values + (i * groups * structured_kept), b, ldb);
+          }
+        },
+        std::max<std::size_t>(
+            execution::default_grain / std::max<std::size_t>(K / 2, 1), 1));
+    return;
+  }
+
+  const auto row_blocks = (M + rows - 1) / rows;
+  execution::for_each_chunk(
+      policy, row_blocks,
+      [&](std::size_t block_begin, std::size_t block_end) {
+        for (auto r = block_begin; r < block_end; ++r) {
+          run(r * rows, std::min((r + 1) * rows, M));
+        }
+      },
+      std::max<std::size_t>(execution::default_grain /
+                                std::max<std::size_t>(rows * (K / 2) * N, 1),
+                            1));
+}
+
+} // namespace venus::kernels
@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <venus/float16.hpp>
+#include <venus/parallel/execution.hpp>
+
+namespace venus::kernels {
+
+// Unsigned integer whose order matches the values of T, for radix sorting.
+// Floats flip their sign bit (and every bit of negatives); -0 maps to +0 and
+// every NaN to one key above +inf, so equal values get equal keys.
+template <typename T> struct RadixKey {
+  using type = std::conditional_t<sizeof(accumulator_t<T>) == 8, std::uint64_t,
+                                  std::uint32_t>;
+};
+
+template <std::integral T> struct RadixKey<T> {
+  using type = std::make_unsigned_t<T>;
+};
+
+template <> struct RadixKey<bool> {
+  using type = std::uint8_t;
+};
+
+template <typename T> using radix_key_t = typename RadixKey<T>::type;
+
+template <typename T> constexpr auto radix_key(T value) -> radix_key_t<T> {
+  using Key = radix_key_t<T>;
+  constexpr auto sign = Key{1} << ((sizeof(Key) * CHAR_BIT) - 1);
+  if constexpr (std::is_same_v<T, bool>) {
+    return static_cast<Key>(value);
+  } else if constexpr (std::is_integral_v<T>) {
+    return static_cast<Key>(static_cast<Key>(value) ^
+                            (std::is_signed_v<T> ? sign : Key{0}));
+  } else {
+    using F = accumulator_t<T>;
+    auto number = static_cast<F>(value);
+    if (number != number) {
+      number = std::numeric_limits<F>::quiet_NaN();
+    } else if (number == F{0}) {
+      number = F{0};
+    }
+    const auto bits = std::bit_cast<Key>(number);
+    return (bits & sign) != 0 ? static_cast<Key>(~bits) : (bits | sign);
+  }
+}
+
+// Stable least-significant-digit radix sort of `keys`, carrying `order`
+// along; both are sorted in place. Each pass histograms one byte per thread
+// and scatters every thread's share to its own offsets, so the passes
+// parallelize without sharing counters. Passes on a byte that all keys
+// share are skipped.
+template <typename Key, typename Policy>
+void radix_sort(Policy &&policy, Key *keys, std::size_t *order,
+                std::size_t count) {
+  constexpr std::size_t radix = 256;
+  const auto pieces = execution::partitions(policy, count);
+  const auto piece_begin = [&](std::size_t piece) {
+    return (piece * count) / pieces;
+  };
+
+  auto key_buffer = std::make_unique<Key[]>(count);
+  auto order_buffer = std::make_unique<std::size_t[]>(count);
+  auto offsets = std::make_unique<std::array<std::size_t, radix>[]>(pieces);
+  Key *from_keys = keys;
+  Key *to_keys = key_buffer.get();
+  std::size_t *from_order = order;
+  std::size_t *to_order = order_buffer.get();
+
+  for (std::size_t shift = 0; shift < sizeof(Key) * CHAR_BIT; shift += 8) {
+    const auto digit = [shift](Key key) {
+      return static_cast<std::size_t>((key >> shift) & (radix - 1));
+    };
+
+    execution::for_each_chunk(
+        policy, pieces,
+        [&](std::size_t begin, std::size_t end) {
+          for (auto piece = begin; piece < end; ++piece) {
+            auto &histogram = offsets[piece];
+            histogram.fill(0);
+            for (auto i = piece_begin(piece); i < piece_begin(piece + 1);
+                 ++i) {
+              ++histogram[digit(from_keys[i])];
+            }
+          }
+        },
+        1);
+
+    // Exclusive offsets, digit-major and piece-minor so the scatter is
+    // stable
+    std::size_t next = 0;
+    bool single_digit = false;
+    for (std::size_t d = 0; d < radix; ++d) {
+      std::size_t with_digit = 0;
+      for (std::size_t piece = 0; piece < pieces; ++piece) {
+        const auto n = offsets[piece][d];
+        offsets[piece][d] = next;
+        next += n;
+        with_digit += n;
+      }
+      single_digit = single_digit or with_digit == count;
+    }
+    if (single_digit) {
+      continue;
+    }
+
+    execution::for_each_chunk(
+        policy, pieces,
+        [&](std::size_t begin, std::size_t end) {
+          for (auto piece = begin; piece < end; ++piece) {
+            auto &position = offsets[piece];
+            for (auto i = piece_begin(piece); i < piece_begin(piece + 1);
+                 ++i) {
+              const auto at = position[digit(from_keys[i])]++;
+              to_keys[at] = from_keys[i];
+              to_order[at] = from_order[i];
+            }
+          }
+        },
+        1);
+    std::swap(from_keys, to_keys);
+    std::swap(from_order, to_order);
+  }
+
+  if (from_keys != keys) {
+    std::copy(from_keys, from_keys + count, keys);
+    std::copy(from_order, from_order + count, order);
+  }
+}
+
+// Open-addressing (linear probing) index from keys to dense ids, given out
+// in order of first insertion. The table doubles at half load.
+template <typename Key> class KeyIndex {
+public:
+  KeyIndex() { rehash(64); }
+
+  // Id of `key`, which is size() - 1 if the key is new
+  auto insert(Key key) -> std::size_t {
+    auto slot = home(key);
+    while (m_slot_ids[slot] != 0) {
+      if (m_slot_keys[slot] == key) {
+        return m_slot_ids[slot] - 1;
+      }
+      slot = (slot + 1) & m_mask;
+    }
+    m_slot_keys[slot] = key;
+    m_slot_ids[slot] = m_keys.size() + 1;
+    m_keys.push_back(key);
+    if (2 * m_keys.size() > m_mask) {
+      rehash(2 * (m_mask + 1));
+    }
+    return m_keys.size() - 1;
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t { return m_keys.size(); }
+  [[nodiscard]] auto key(std::size_t id) const -> Key { return m_keys[id]; }
+
+private:
+  // Fibonacci hashing: the top bits of key * 2^64 / phi
+  [[nodiscard]] auto home(Key key) const -> std::size_t {
+    return static_cast<std::size_t>(
+               (static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >>
+               m_shift) &
+           m_mask;
+  }
+
+  void rehash(std::size_t capacity) {
+    m_mask = capacity - 1;
+    m_shift = 64 - std::countr_zero(capacity);
+    m_slot_keys = std::make_unique<Key[]>(capacity);
+    m_slot_ids = std::make_unique<std::size_t[]>(capacity);
+    for (std::size_t id = 0; id < m_keys.size(); ++id) {
+      auto slot = home(m_keys[id]);
+      while (m_slot_ids[slot] != 0) {
+        slot = (slot + 1) & m_mask;
+      }
+      m_slot_keys[slot] = m_keys[id];
+      m_slot_ids[slot] = id + 1;
+    }
+  }
+
+  std::vector<Key> m_keys;
+  std::unique_ptr<Key[]> m_slot_keys;
+  std::unique_ptr<std::size_t[]> m_slot_ids; // id + 1, 0 for an empty slot
+  std::size_t m_mask = 0;
+  int m_shift = 0;
+};
+
+// Distinct values of `in` in ascending order, as positions: first[u] is the
+// index of the first occurrence of the u-th value, counts[u] how often it
+// occurs and inverse[i] which u in[i] is. -0 equals +0, and all NaN are one
+// value that sorts last.
+struct UniqueValues {
+  std::size_t size = 0;
+  std::unique_ptr<std::size_t[]> first;
+  std::unique_ptr<std::size_t[]> counts;
+  std::unique_ptr<std::size_t[]> inverse;
+};
+
+// Sorting every key: in[i] is tagged with i and radix sorted, so runs of
+// equal keys start at their first occurrence
+template <typename T, typename Policy>
+auto unique_by_sort(Policy &&policy, const T *in, std::size_t count)
+    -> UniqueValues {
+  using Key = radix_key_t<T>;
+  auto keys = std::make_unique<Key[]>(count);
+  auto order = std::make_unique<std::size_t[]>(count);
+  execution::for_each_chunk(
+      policy, count, [&](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+          keys[i] = radix_key(in[i]);
+          order[i] = i;
+        }
+      });
+  radix_sort(policy, keys.get(), order.get(), count);
+
+  UniqueValues result;
+  result.first = std::make_unique<std::size_t[]>(count);
+  result.counts = std::make_unique<std::size_t[]>(count);
+  result.inverse = std::make_unique<std::size_t[]>(count);
+  for (std::size_t s = 0; s < count; ++s) {
+    if (s == 0 or keys[s] != keys[s - 1]) {
+      result.first[result.size] = order[s];
+      result.counts[result.size++] = 0;
+    }
+    ++result.counts[result.size - 1];
+    result.inverse[order[s]] = result.size - 1;
+  }
+  return result;
+}
+
+// Hashing: every thread indexes the keys of its share in a table of its
+// own, and the tables are merged in order, so the first piece holding a
+// value also holds its first occurrence. Only the distinct keys are then
+// sorted, and the inverse is translated from local ids to sorted positions.
+// Gives up (returning nothing) once a share holds more than 2^16 distinct
+// values and more than one per 16 elements: sorting everything is then
+// cheaper than probing a table that no longer fits in cache.
+template <typename T, typename Policy>
+auto unique_by_hash(Policy &&policy, const T *in, std::size_t count)
+    -> std::optional<UniqueValues> {
+  using Key = radix_key_t<T>;
+  constexpr std::size_t min_distinct = std::size_t{1} << 16;
+  struct Piece {
+    KeyIndex<Key> index;
+    std::vector<std::size_t> first;
+    std::vector<std::size_t> counts;
+    std::vector<std::size_t> merged; // global id of every local id
+  };
+
+  UniqueValues result;
+  result.inverse = std::make_unique<std::size_t[]>(count);
+  const auto pieces = execution::partitions(policy, count);
+  auto parts = std::make_unique<Piece[]>(pieces);
+  std::atomic<bool> too_many{false};
+
+  execution::for_each_chunk(
+      policy, pieces,
+      [&](std::size_t piece_begin, std::size_t piece_end) {
+        for (auto piece = piece_begin; piece < piece_end; ++piece) {
+          auto &part = parts[piece];
+          const auto begin = (piece * count) / pieces;
+          const auto end = ((piece + 1) * count) / pieces;
+          const auto limit = std::max(min_distinct, (end - begin) / 16);
+          for (auto i = begin; i < end; ++i) {
+            const auto id = part.index.insert(radix_key(in[i]));
+            if (id == part.first.size()) {
+              if (id == limit or too_many.load(std::memory_order_relaxed)) {
+                too_many.store(true, std::memory_order_relaxed);
+                return;
+              }
+              part.first.push_back(i);
+              part.counts.push_back(0);
+            }
+            ++part.counts[id];
+            result.inverse[i] = id;
+          }
+        }
+      },
+      1);
+  if (too_many) {
+    return std::nullopt;
+  }
+
+  KeyIndex<Key> index;
+  std::vector<std::size_t> first;
+  std::vector<std::size_t> counts;
+  for (std::size_t piece = 0; piece < pieces; ++piece) {
+    auto &part = parts[piece];
+    part.merged.resize(part.index.size());
+    for (std::size_t id = 0; id < part.index.size(); ++id) {
+      const auto global = index.insert(part.index.key(id));
+      if (global == first.size()) {
+        first.push_back(part.first[id]);
+        counts.push_back(0);
+      }
+      counts[global] += part.counts[id];
+      part.merged[id] = global;
+    }
+  }
+
+  result.size = index.size();
+  auto keys = std::make_unique<Key[]>(result.size);
+  auto order = std::make_unique<std::size_t[]>(result.size);
+  for (std::size_t id = 0; id < result.size; ++id) {
+    keys[id] = index.key(id);
+    order[id] = id;
+  }
+  radix_sort(policy, keys.get(), order.get(), result.size);
+
+  auto rank = std::make_unique<std::size_t[]>(result.size);
+  result.first = std::make_unique<std::size_t[]>(result.size);
+  result.counts = std::make_unique<std::size_t[]>(result.size);
+  for (std::size_t u = 0; u < result.size; ++u) {
+    rank[order[u]] = u;
+    result.first[u] = first[order[u]];
+    result.counts[u] = counts[order[u]];
+  }
+
+  execution::for_each_chunk(
+      policy, pieces,
+      [&](std::size_t piece_begin, std::size_t piece_end) {
+        for (auto piece = piece_begin; piece < piece_end; ++piece) {
+          const auto &merged = parts[piece].merged;
+          const auto end = ((piece + 1) * count) / pieces;
+          for (auto i = (piece * count) / pieces; i < end; ++i) {
+            result.inverse[i] = rank[merged[result.inverse[i]]];
+          }
+        }
+      },
+      1);
+  return result;
+}
+
+// Hashes while the values repeat, as in most categorical data, and sorts
+// every key when they are mostly distinct
+template <typename T, typename Policy>
+auto unique(Policy &&policy, const T *in, std::size_t count) -> UniqueValues {
+  if (auto hashed = unique_by_hash(policy, in, count)) {
+    return std::move(*hashed);
+  }
+  return unique_by_sort(policy, in, count);
+}
+
+} // namespace venus::kernels
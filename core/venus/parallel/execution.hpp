@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <venus/parallel/thread_pool.hpp>
+
+// Asks the compiler to vectorize the following loop even when it cannot prove
+// the iterations independent, which unsequenced policies guarantee
+#if defined(__clang__)
+#define VENUS_UNSEQ_LOOP _Pragma("clang loop vectorize(enable)")
+#elif defined(__GNUC__)
+#define VENUS_UNSEQ_LOOP _Pragma("GCC ivdep")
+#else
+#define VENUS_UNSEQ_LOOP
+#endif
+
+namespace venus::execution {
+
+// Execution policies for eager ops, mirroring std::execution. Parallel
+// policies split the work across venus::ThreadPool, unsequenced ones allow
+// the per-chunk loop to be vectorized.
+struct sequenced_policy {};
+struct unsequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy {};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr unsequenced_policy unseq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+template <typename T>
+concept ExecutionPolicy =
+    std::is_same_v<std::remove_cvref_t<T>, sequenced_policy> or
+    std::is_same_v<std::remove_cvref_t<T>, unsequenced_policy> or
+    std::is_same_v<std::remove_cvref_t<T>, parallel_policy> or
+    std::is_same_v<std::remove_cvref_t<T>, parallel_unsequenced_policy>;
+
+template <ExecutionPolicy Policy>
+inline constexpr bool is_parallel_v =
+    std::is_same_v<std::remove_cvref_t<Policy>, parallel_policy> or
+    std::is_same_v<std::remove_cvref_t<Policy>, parallel_unsequenced_policy>;
+
+template <ExecutionPolicy Policy>
+inline constexpr bool is_unsequenced_v =
+    std::is_same_v<std::remove_cvref_t<Policy>, unsequenced_policy> or
+    std::is_same_v<std::remove_cvref_t<Policy>, parallel_unsequenced_policy>;
+
+// Elements per chunk below which spreading work over threads does not pay
+// for the synchronization
+inline constexpr std::size_t default_grain = std::size_t{1} << 14;
+
+// Runs fn(begin, end) over [0, count): in one piece for sequential policies,
+// in chunks across the thread pool for parallel ones
+template <ExecutionPolicy Policy, typename Fn>
+void for_each_chunk(Policy && /*policy*/, std::size_t count, Fn &&fn,
+                    std::size_t grain = default_grain) {
+  if constexpr (is_parallel_v<Policy>) {
+    ThreadPool::instance().parallelFor(count, grain, std::forward<Fn>(fn));
+  } else if (count > 0) {
+    fn(std::size_t{0}, count);
+  }
+}
+
+// Number of pieces a pass over `count` elements splits into under the
+// policy: one per thread that gets at least `grain` of them. Passes that
+// keep scratch per piece (partial histograms, digit counts) run their
+// pieces with for_each_chunk(policy, pieces, fn, 1).
+template <ExecutionPolicy Policy>
+auto partitions(Policy && /*policy*/, std::size_t count,
+                std::size_t grain = default_grain) -> std::size_t {
+  if constexpr (is_parallel_v<Policy>) {
+    const auto chunks = (count + grain - 1) / std::max<std::size_t>(grain, 1);
+    return std::clamp<std::size_t>(chunks, 1, ThreadPool::instance().size());
+  } else {
+    return 1;
+  }
+}
+
+} // namespace venus::execution
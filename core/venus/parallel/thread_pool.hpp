@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace venus {
+
+// Fixed-size pool of worker threads shared by all parallel eager ops. The
+// calling thread always takes part in the work, so a pool of size N runs on
+// N - 1 workers plus the caller.
+class ThreadPool {
+public:
+  explicit ThreadPool(std::size_t num_threads)
+      : m_size(std::max<std::size_t>(num_threads, 1)) {
+    m_workers.reserve(m_size - 1);
+    for (std::size_t i = 1; i < m_size; ++i) {
+      m_workers.emplace_back([this] { workerLoop(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+  ~ThreadPool() {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      m_stop = true;
+    }
+    m_wakeup.notify_all();
+    for (auto &worker : m_workers) {
+      worker.join();
+    }
+  }
+
+  // Process-wide pool, sized by VENUS_NUM_THREADS or the hardware
+  static auto instance() -> ThreadPool & {
+    static ThreadPool pool(defaultThreadCount());
+    return pool;
+  }
+
+  static auto defaultThreadCount() -> std::size_t {
+    if (const char *env = std::getenv("VENUS_NUM_THREADS")) {
+      try {
+        if (const auto requested = std::stoul(env); requested > 0) {
+          return requested;
+        }
+      } catch (const std::exception &) {
+        // fall through to the hardware default
+      }
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+  // Calls fn(begin, end) over disjoint chunks covering [0, count), each at
+  // least `grain` long, and blocks until all of them are done. The first
+  // exception thrown by a chunk is rethrown here. Calls made from inside a
+  // chunk run serially on the calling thread instead of oversubscribing.
+  template <typename Fn>
+  void parallelFor(std::size_t count, std::size_t grain, Fn &&fn) {
+    if (count == 0) {
+      return;
+    }
+    grain = std::max<std::size_t>(grain, 1);
+    const auto chunks = std::min(m_size, (count + grain - 1) / grain);
+    if (chunks <= 1 or t_inside_parallel_region) {
+      fn(std::size_t{0}, count);
+      return;
+    }
+
+    // Completion is tracked under a mutex rather than a latch: the caller
+    // may only return (and destroy this frame) once the last chunk has
+    // released the lock
+    std::atomic<std::size_t> next_chunk{0};
+    std::size_t pending = chunks;
+    std::exception_ptr error;
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+
+    auto run = [&] {
+      const auto was_inside = std::exchange(t_inside_parallel_region, true);
+      std::exception_ptr chunk_error;
+      for (auto chunk = next_chunk++; chunk < chunks; chunk = next_chunk++) {
+        try {
+          fn((chunk * count) / chunks, ((chunk + 1) * count) / chunks);
+        } catch (...) {
+          chunk_error = std::current_exception();
+        }
+      }
+      t_inside_parallel_region = was_inside;
+
+      auto lock = std::lock_guard(done_mutex);
+      if (chunk_error and not error) {
+        error = chunk_error;
+      }
+      if (--pending == 0) {
+        done_cv.notify_one();
+      }
+    };
+
+    {
+      auto lock = std::lock_guard(m_mutex);
+      for (std::size_t i = 1; i < chunks; ++i) {
+        m_tasks.emplace(run);
+      }
+    }
+    m_wakeup.notify_all();
+
+    run();
+    {
+      auto lock = std::unique_lock(done_mutex);
+      done_cv.wait(lock, [&] { return pending == 0; });
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  void workerLoop() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        auto lock = std::unique_lock(m_mutex);
+        m_wakeup.wait(lock, [this] { return m_stop or not m_tasks.empty(); });
+        if (m_stop and m_tasks.empty()) {
+          return;
+        }
+        task = std::move(m_tasks.front());
+        m_tasks.pop();
+      }
+      task();
+    }
+  }
+
+  static inline thread_local bool t_inside_parallel_region = false;
+
+  std::size_t m_size;
+  std::vector<std::thread> m_workers;
+  std::queue<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  bool m_stop = false;
+};
+
+} // namespace venus
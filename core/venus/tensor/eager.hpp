@@ -2,18 +2,38 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <format>
 #include <functional>
+#include <memory>
 #include <numeric>
+#include <optional>
 #include <ranges>
 #include <stdexcept>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <venus/float16.hpp>
+#include <venus/kernels/convert.hpp>
+#include <venus/kernels/epilogue.hpp>
+#include <venus/kernels/gemm.hpp>
+#include <venus/kernels/gemm_tuning.hpp>
+#include <venus/kernels/gemv.hpp>
+#include <venus/kernels/histogram.hpp>
+#include <venus/kernels/predicate.hpp>
+#include <venus/kernels/reduce.hpp>
+#include <venus/kernels/scan.hpp>
+#include <venus/kernels/segment.hpp>
+#include <venus/kernels/select.hpp>
+#include <venus/kernels/small_matrix.hpp>
+#include <venus/kernels/softmax.hpp>
+#include <venus/kernels/unique.hpp>
 #include <venus/memory/device.hpp>
+#include <venus/parallel/execution.hpp>
 #include <venus/str.hpp>
 #include <venus/tensor/shape.hpp>
 
@@ -30,7 +50,7 @@ concept VenusTensor = requires {
 };
 
 template <typename T>
-concept Scalar = std::is_arithmetic_v<std::remove_cvref_t<T>>;
+concept Scalar = std::is_arithmetic_v<std::remove_cvref_t<T>> || HalfFloat<T>;
 
 template <typename T>
 concept ScalarTensor =
@@ -71,8 +91,248 @@ concept BoolTensor =
     }                                                                          \
   }
 
+#define REGISTER_FUSED_WHERE(op_name, std_op)                                  \
+  template <typename T1, typename T2, typename T3, typename T4>                \
+    requires(Scalar<T1> || VenusTensor<T1>) &&                                 \
+            (Scalar<T2> || VenusTensor<T2>) &&                                 \
+            (Scalar<T3> || VenusTensor<T3>) &&                                 \
+            (Scalar<T4> || VenusTensor<T4>) &&                                 \
+            (MDTensor<T1> || MDTensor<T2> || MDTensor<T3> || MDTensor<T4>)     \
+  auto op_name(const T1 &lhs, const T2 &rhs, const T3 &true_val,               \
+               const T4 &false_val) {                                          \
+    return detail::nary_elementwise_op(                                        \
+        [](auto l, auto r, auto t, auto f) {                                   \
+          return std::std_op{}(l, r) ? t : f;                                  \
+        },                                                                     \
+        detail::unwrap_scalar_tensor(lhs), detail::unwrap_scalar_tensor(rhs),  \
+        detail::unwrap_scalar_tensor(true_val),                                \
+        detail::unwrap_scalar_tensor(false_val));                              \
+  }
+
+#define REGISTER_FUSED_TERNARY_OP(op_name, kernel)                            \
+  template <typename T1, typename T2, typename T3>                             \
+    requires(Scalar<T1> || VenusTensor<T1>) &&                                 \
+            (Scalar<T2> || VenusTensor<T2>) &&                                 \
+            (Scalar<T3> || VenusTensor<T3>) &&                                 \
+            (MDTensor<T1> || MDTensor<T2> || MDTensor<T3>)                     \
+  auto op_name(const T1 &t1, const T2 &t2, const T3 &t3) {                     \
+    return detail::nary_elementwise_op(                                        \
+        [](auto a, auto b, auto c) { return detail::kernel(a, b, c); },        \
+        detail::unwrap_scalar_tensor(t1), detail::unwrap_scalar_tensor(t2),    \
+        detail::unwrap_scalar_tensor(t3));                                     \
+  }
+
+#define REGISTER_FUSED_PREDICATE(suffix, std_op)                               \
+  template <execution::ExecutionPolicy Policy,                                 \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank, Scalar Value>         \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto any_##suffix(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,         \
+                    Value value) -> bool {                                     \
+    return detail::any_of(policy, t, [value](auto element) {                   \
+      return detail::compare<std::std_op<>>(element, value);                   \
+    });                                                                        \
+  }                                                                            \
+                                                                               \
+  template <execution::ExecutionPolicy Policy,                                 \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank, Scalar Value>         \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto all_##suffix(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,         \
+                    Value value) -> bool {                                     \
+    return not detail::any_of(policy, t, [value](auto element) {               \
+      return not detail::compare<std::std_op<>>(element, value);               \
+    });                                                                        \
+  }                                                                            \
+                                                                               \
+  template <execution::ExecutionPolicy Policy,                                 \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank, Scalar Value>         \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto count_##suffix(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,       \
+                      Value value) -> std::size_t {                            \
+    return detail::count_if(policy, t, [value](auto element) {                 \
+      return detail::compare<std::std_op<>>(element, value);                   \
+    });                                                                        \
+  }                                                                            \
+                                                                               \
+  template <template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank, Scalar Value>         \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto any_##suffix(const Tensor<Elem, Dev, Rank> &t, Value value) -> bool {   \
+    return any_##suffix(execution::seq, t, value);                             \
+  }                                                                            \
+                                                                               \
+  template <template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank, Scalar Value>         \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto all_##suffix(const Tensor<Elem, Dev, Rank> &t, Value value) -> bool {   \
+    return all_##suffix(execution::seq, t, value);                             \
+  }                                                                            \
+                                                                               \
+  template <template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank, Scalar Value>         \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto count_##suffix(const Tensor<Elem, Dev, Rank> &t, Value value)           \
+      -> std::size_t {                                                         \
+    return count_##suffix(execution::seq, t, value);                           \
+  }
+
+#define REGISTER_REDUCTION(op_name, reducer)                                   \
+  template <std::size_t... Dims, execution::ExecutionPolicy Policy,            \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank,                       \
+            ReductionOption... Options>                                        \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto op_name(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,              \
+               Options... options) {                                           \
+    return detail::reduce<kernels::reducer, Dims...>(policy, t, options...);   \
+  }                                                                            \
+                                                                               \
+  template <std::size_t... Dims,                                               \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank,                       \
+            ReductionOption... Options>                                        \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto op_name(const Tensor<Elem, Dev, Rank> &t, Options... options) {         \
+    return detail::reduce<kernels::reducer, Dims...>(execution::seq, t,        \
+                                                     options...);              \
+  }
+
+#define REGISTER_ARG_REDUCTION(op_name, order, with_values)                    \
+  template <std::size_t... Axis, execution::ExecutionPolicy Policy,            \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank,                       \
+            std::same_as<squeeze_t>... Options>                                \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto op_name(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,              \
+               Options... options) {                                           \
+    return detail::arg_reduce<kernels::order, with_values, Axis...>(           \
+        policy, t, options...);                                                \
+  }                                                                            \
+                                                                               \
+  template <std::size_t... Axis,                                               \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank,                       \
+            std::same_as<squeeze_t>... Options>                                \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto op_name(const Tensor<Elem, Dev, Rank> &t, Options... options) {         \
+    return detail::arg_reduce<kernels::order, with_values, Axis...>(           \
+        execution::seq, t, options...);                                        \
+  }
+
+#define REGISTER_SEGMENT_REDUCTION(op_name, reducer)                          \
+  template <execution::ExecutionPolicy Policy,                                 \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank>                       \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto op_name(Policy &&policy, const Tensor<Elem, Dev, Rank> &values,         \
+               const Tensor<std::size_t, Dev, 1> &segment_ids) {               \
+    return detail::segment_reduce<kernels::reducer>(                           \
+        policy, values, segment_ids, std::nullopt);                            \
+  }                                                                            \
+                                                                               \
+  template <execution::ExecutionPolicy Policy,                                 \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank>                       \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto op_name(Policy &&policy, const Tensor<Elem, Dev, Rank> &values,         \
+               const Tensor<std::size_t, Dev, 1> &segment_ids,                 \
+               std::size_t num_segments) {                                     \
+    return detail::segment_reduce<kernels::reducer>(                           \
+        policy, values, segment_ids, num_segments);                            \
+  }                                                                            \
+                                                                               \
+  template <template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank>                       \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto op_name(const Tensor<Elem, Dev, Rank> &values,                          \
+               const Tensor<std::size_t, Dev, 1> &segment_ids) {               \
+    return detail::segment_reduce<kernels::reducer>(                           \
+        execution::seq, values, segment_ids, std::nullopt);                    \
+  }                                                                            \
+                                                                               \
+  template <template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank>                       \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto op_name(const Tensor<Elem, Dev, Rank> &values,                          \
+               const Tensor<std::size_t, Dev, 1> &segment_ids,                 \
+               std::size_t num_segments) {                                     \
+    return detail::segment_reduce<kernels::reducer>(                           \
+        execution::seq, values, segment_ids, num_segments);                    \
+  }
+
+#define REGISTER_SCAN(op_name, reducer)                                        \
+  template <std::size_t... Axis, execution::ExecutionPolicy Policy,            \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank>                       \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto op_name(Policy &&policy, const Tensor<Elem, Dev, Rank> &t) {            \
+    return detail::scan<kernels::reducer, Axis...>(policy, t);                 \
+  }                                                                            \
+                                                                               \
+  template <std::size_t... Axis,                                               \
+            template <typename, typename, std::size_t> class Tensor,           \
+            Scalar Elem, typename Dev, std::size_t Rank>                       \
+    requires VenusTensor<Tensor<Elem, Dev, Rank>>                              \
+  auto op_name(const Tensor<Elem, Dev, Rank> &t) {                             \
+    return detail::scan<kernels::reducer, Axis...>(execution::seq, t);         \
+  }
+
 namespace venus::eager {
 
+// Reduction options ==================================================
+
+// Selects the squeezed variant of a reduction: reduced axes are removed
+// instead of kept with extent 1
+struct squeeze_t {
+  explicit constexpr squeeze_t() = default;
+};
+inline constexpr squeeze_t squeeze{};
+
+// Summation modes for sums, means and inner products. pairwise halves the
+// reduced range down to short runs, so the rounding error grows with
+// log(n); kahan keeps a (Neumaier) error term next to every accumulator, so
+// it barely grows at all. Both keep the SIMD lanes of the default mode.
+struct pairwise_t {
+  explicit constexpr pairwise_t() = default;
+};
+inline constexpr pairwise_t pairwise{};
+
+struct kahan_t {
+  explicit constexpr kahan_t() = default;
+};
+inline constexpr kahan_t kahan{};
+
+template <typename T>
+concept SummationMode = std::is_same_v<T, pairwise_t> or
+                        std::is_same_v<T, kahan_t>;
+
+template <typename T>
+concept ReductionOption = std::is_same_v<T, squeeze_t> or SummationMode<T>;
+
+// Matrix multiplication options ======================================
+
+// Multiplies by the transpose of the first (trans_a) or second (trans_b)
+// operand as it is stored: the packing routines read it in place, so
+// row-major weights and keys are never transposed into a copy
+struct trans_a_t {
+  explicit constexpr trans_a_t() = default;
+};
+inline constexpr trans_a_t trans_a{};
+
+struct trans_b_t {
+  explicit constexpr trans_b_t() = default;
+};
+inline constexpr trans_b_t trans_b{};
+
+template <typename T>
+concept MatMulOption = std::is_same_v<T, trans_a_t> or
+                       std::is_same_v<T, trans_b_t>;
+
+// Activations fused into linear layers
+using kernels::Activation;
+
 // Details =====================================================
 namespace detail {
 
@@ -167,6 +427,641 @@ auto ternary_elementwise_op(Op op, const Tensor<Elem1, Dev1, Rank1> &t1,
   }
 }
 
+template <typename T> constexpr auto operand_rank() -> std::size_t {
+  if constexpr (VenusTensor<T>) {
+    return std::remove_cvref_t<T>::rank;
+  } else {
+    return 0;
+  }
+}
+
+template <typename T> decltype(auto) unwrap_scalar_tensor(const T &operand) {
+  if constexpr (ScalarTensor<T>) {
+    return operand.value();
+  } else {
+    return (operand);
+  }
+}
+
+// Hoisted per-operand access for the flat loop: raw pointer or scalar value
+template <typename T> auto flat_reader(const T &operand) {
+  if constexpr (Scalar<T>) {
+    return operand;
+  } else {
+    return operand.data();
+  }
+}
+
+template <typename Reader>
+auto read_flat(const Reader &reader, std::size_t flat) {
+  if constexpr (std::is_pointer_v<Reader>) {
+    return reader[flat];
+  } else {
+    return reader;
+  }
+}
+
+template <std::size_t RankOut, typename T>
+auto read_broadcast(const T &operand,
+                    const std::array<std::size_t, RankOut> &out_idx) {
+  if constexpr (Scalar<T>) {
+    return operand;
+  } else {
+    return operand[project_broadcast_idx(out_idx, operand.shape())];
+  }
+}
+
+template <typename First, typename... Rest> struct first_md_tensor {
+  using type = typename first_md_tensor<Rest...>::type;
+};
+
+template <typename First, typename... Rest>
+  requires MDTensor<First>
+struct first_md_tensor<First, Rest...> {
+  using type = std::remove_cvref_t<First>;
+};
+
+template <typename T, typename Elem, std::size_t Rank> struct rebind_tensor;
+
+template <template <typename, typename, std::size_t> class Tensor,
+          typename Elem, typename Dev, std::size_t Rank, typename NewElem,
+          std::size_t NewRank>
+struct rebind_tensor<Tensor<Elem, Dev, Rank>, NewElem, NewRank> {
+  using type = Tensor<NewElem, Dev, NewRank>;
+};
+
+// Elementwise op over any mix of scalars and (broadcastable) tensors, in a
+// single pass and without intermediate tensors between the operands and op.
+template <typename Op, typename... Operands>
+  requires(MDTensor<Operands> || ...) &&
+          ((Scalar<Operands> || MDTensor<Operands>) && ...)
+auto nary_elementwise_op(Op op, const Operands &...operands) {
+  constexpr std::size_t RankOut = std::max({operand_rank<Operands>()...});
+
+  using ResultElementType = std::remove_cvref_t<
+      std::invoke_result_t<Op, decltype(read_flat(flat_reader(operands),
+                                                  0))...>>;
+  using ResultTensor =
+      typename rebind_tensor<typename first_md_tensor<Operands...>::type,
+                             ResultElementType, RankOut>::type;
+
+  std::array<std::size_t, RankOut> ones{};
+  ones.fill(1);
+  auto out_shape = Shape<RankOut>(ones);
+  (
+      [&](const auto &operand) {
+        if constexpr (MDTensor<decltype(operand)>) {
+          out_shape = broadcast<RankOut>(out_shape, operand.shape());
+        }
+      }(operands),
+      ...);
+
+  auto result = ResultTensor(out_shape);
+  auto *out_ptr = result.data();
+
+  const auto same_shape = [&out_shape](const auto &operand) {
+    using T = std::remove_cvref_t<decltype(operand)>;
+    if constexpr (Scalar<T>) {
+      return true;
+    } else if constexpr (T::rank != RankOut) {
+      return false;
+    } else {
+      return operand.shape() == out_shape;
+    }
+  };
+
+  // Does not need broadcasting
+  if ((same_shape(operands) && ...)) {
+    const auto readers = std::make_tuple(flat_reader(operands)...);
+    std::apply(
+        [&](const auto &...reader) {
+          for (std::size_t flat = 0; flat < result.size(); ++flat) {
+            out_ptr[flat] = op(read_flat(reader, flat)...);
+          }
+        },
+        readers);
+    return result;
+  }
+
+  // Needs broadcasting
+  for (std::size_t flat = 0; flat < result.size(); ++flat) {
+    const auto out_idx = out_shape.offsetToIdx(flat);
+    out_ptr[flat] = op(read_broadcast(operands, out_idx)...);
+  }
+
+  return result;
+}
+
+// fn(i) for every i in [0, count), split and vectorized as the policy allows
+template <execution::ExecutionPolicy Policy, typename Fn>
+void for_each_index(Policy &&policy, std::size_t count, Fn &fn) {
+  execution::for_each_chunk(
+      policy, count, [&](std::size_t begin, std::size_t end) {
+        if constexpr (execution::is_unsequenced_v<Policy>) {
+          VENUS_UNSEQ_LOOP
+          for (auto i = begin; i < end; ++i) {
+            fn(i);
+          }
+        } else {
+          for (auto i = begin; i < end; ++i) {
+            fn(i);
+          }
+        }
+      });
+}
+
+// dst[i] = fn(src[i]) over raw contiguous memory. src and dst may alias for
+// in-place transforms.
+template <execution::ExecutionPolicy Policy, typename In, typename Out,
+          typename Fn>
+void transform_range(Policy &&policy, const In *src, Out *dst,
+                     std::size_t count, Fn &fn) {
+  auto body = [&](std::size_t i) { dst[i] = fn(src[i]); };
+  for_each_index(policy, count, body);
+}
+
+// a * b + c, as a single fused instruction when the target has one (std::fma
+// is a slow library call otherwise)
+template <typename T> auto multiply_add(T a, T b, T c) -> T {
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA)
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::fma(a, b, c);
+  }
+#endif
+  return static_cast<T>((a * b) + c);
+}
+
+template <typename A, typename B, typename C>
+auto fused_multiply_add(A a, B b, C c) {
+  using ResultType = std::common_type_t<A, B, C>;
+  using AccumulatorType = accumulator_t<ResultType>;
+  return static_cast<ResultType>(multiply_add(static_cast<AccumulatorType>(a),
+                                              static_cast<AccumulatorType>(b),
+                                              static_cast<AccumulatorType>(c)));
+}
+
+// a + t * (b - a)
+template <typename A, typename B, typename T>
+auto linear_interpolate(A a, B b, T t) {
+  using ResultType = std::common_type_t<A, B, T>;
+  using AccumulatorType = accumulator_t<ResultType>;
+  const auto from = static_cast<AccumulatorType>(a);
+  return static_cast<ResultType>(
+      multiply_add(static_cast<AccumulatorType>(t),
+                   static_cast<AccumulatorType>(b) - from, from));
+}
+
+template <typename T> void require_unique(const T &tensor) {
+  if (not tensor.unique()) {
+    throw std::runtime_error("Cannot write to shared tensor");
+  }
+}
+
+template <typename T1, typename T2>
+void require_same_shape(const T1 &t1, const T2 &t2) {
+  if (t1.shape() != t2.shape()) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch between tensors in in-place op: t1 has "
+                    "shape {}, whereas t2 has shape {}.",
+                    t1.shape(), t2.shape()));
+  }
+}
+
+template <std::size_t Rank, std::size_t... Dims>
+consteval auto reduction_mask() -> std::array<bool, Rank> {
+  std::array<bool, Rank> mask{};
+  if constexpr (sizeof...(Dims) == 0) {
+    mask.fill(true);
+  } else {
+    ((mask[Dims] = true), ...);
+  }
+  return mask;
+}
+
+// Rank of the result: squeezed (or full) reductions drop the reduced axes,
+// keepdim reductions preserve the rank
+template <bool Squeeze, std::size_t Rank, std::size_t... Dims>
+consteval auto reduction_rank() -> std::size_t {
+  if constexpr (Squeeze or sizeof...(Dims) == 0) {
+    return static_cast<std::size_t>(
+        std::ranges::count(reduction_mask<Rank, Dims...>(), false));
+  } else {
+    return Rank;
+  }
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+auto shape_extents(const Tensor<Elem, Dev, Rank> &t)
+    -> std::array<std::size_t, Rank> {
+  std::array<std::size_t, Rank> extents{};
+  for (std::size_t d = 0; d < Rank; ++d) {
+    extents[d] = t.shape()[d];
+  }
+  return extents;
+}
+
+// Result tensor for reducing t over Dims: reduced axes get extent 1, or are
+// dropped when squeezed
+template <typename Result, bool Squeeze, std::size_t... Dims,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+auto reduction_result(const Tensor<Elem, Dev, Rank> &t) {
+  constexpr auto mask = reduction_mask<Rank, Dims...>();
+  constexpr auto RankOut = reduction_rank<Squeeze, Rank, Dims...>();
+
+  if constexpr (RankOut == 0) {
+    return Tensor<Result, Dev, 0>();
+  } else {
+    std::array<std::size_t, RankOut> out_ext;
+    for (std::size_t d = 0, o = 0; d < Rank; ++d) {
+      if constexpr (RankOut == Rank) {
+        out_ext[o++] = mask[d] ? 1 : t.shape()[d];
+      } else if (not mask[d]) {
+        out_ext[o++] = t.shape()[d];
+      }
+    }
+    return Tensor<Result, Dev, RankOut>(Shape<RankOut>(out_ext));
+  }
+}
+
+// [outer, extent, inner] view around Axis; without an axis the whole tensor
+// is a single row
+template <std::size_t... Axis, std::size_t Rank>
+auto axis_view(const std::array<std::size_t, Rank> &extents)
+    -> kernels::AxisView {
+  kernels::AxisView view;
+  if constexpr (sizeof...(Axis) == 0) {
+    for (auto extent : extents) {
+      view.extent *= extent;
+    }
+  } else {
+    constexpr std::size_t axis = (Axis, ...);
+    for (std::size_t d = 0; d < Rank; ++d) {
+      auto &part = d < axis ? view.outer : d == axis ? view.extent : view.inner;
+      part *= extents[d];
+    }
+  }
+  return view;
+}
+
+// Reducer and fold order for the summation mode among the options: kahan
+// compensates floating point accumulators (integer sums are already exact)
+template <typename Op, typename... Options> struct Summation {
+  static constexpr bool pairwise = (std::is_same_v<Options, pairwise_t> or ...);
+  static constexpr bool kahan = (std::is_same_v<Options, kahan_t> or ...);
+  static_assert(not(pairwise and kahan), "only one summation mode can be used");
+  static_assert(Op::additive or not(pairwise or kahan),
+                "summation modes only apply to sums, means and inner products");
+
+  using reducer = std::conditional_t<
+      kahan and std::is_floating_point_v<typename Op::accumulator_type>,
+      kernels::Compensated<Op>, Op>;
+};
+
+// Whether pred holds for any element of t, and for how many, with every
+// element read in its accumulation type (fp32 for half precision)
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank, typename Pred>
+auto any_of(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,
+            const Pred &pred) -> bool {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Predicates are currently only supported on CPU");
+  const auto *in = t.data();
+  return kernels::any_of(policy, t.size(), [in, &pred](std::size_t i) {
+    return pred(static_cast<accumulator_t<Elem>>(in[i]));
+  });
+}
+
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank, typename Pred>
+auto count_if(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,
+              const Pred &pred) -> std::size_t {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Predicates are currently only supported on CPU");
+  const auto *in = t.data();
+  return kernels::count_if(policy, t.size(), [in, &pred](std::size_t i) {
+    return pred(static_cast<accumulator_t<Elem>>(in[i]));
+  });
+}
+
+// Integers std::cmp_equal and friends accept: not bool or a character type
+template <typename T>
+concept ComparableInteger =
+    std::is_integral_v<T> and not std::is_same_v<T, bool> and
+    not std::is_same_v<T, char> and not std::is_same_v<T, wchar_t> and
+    not std::is_same_v<T, char8_t> and not std::is_same_v<T, char16_t> and
+    not std::is_same_v<T, char32_t>;
+
+// a op b for a std:: comparison object Op. Integers compare by value, so an
+// unsigned element is greater than a negative scalar instead of the scalar
+// wrapping around; other arithmetic types compare in their common type.
+template <typename Op, typename A, typename B>
+constexpr auto compare(A a, B b) -> bool {
+  if constexpr (ComparableInteger<A> and ComparableInteger<B>) {
+    if constexpr (std::is_same_v<Op, std::greater<>>) {
+      return std::cmp_greater(a, b);
+    } else if constexpr (std::is_same_v<Op, std::greater_equal<>>) {
+      return std::cmp_greater_equal(a, b);
+    } else if constexpr (std::is_same_v<Op, std::less<>>) {
+      return std::cmp_less(a, b);
+    } else if constexpr (std::is_same_v<Op, std::less_equal<>>) {
+      return std::cmp_less_equal(a, b);
+    } else if constexpr (std::is_same_v<Op, std::equal_to<>>) {
+      return std::cmp_equal(a, b);
+    } else {
+      return std::cmp_not_equal(a, b);
+    }
+  } else if constexpr (std::is_arithmetic_v<A> and std::is_arithmetic_v<B>) {
+    using Common = std::common_type_t<A, B>;
+    return Op{}(static_cast<Common>(a), static_cast<Common>(b));
+  } else {
+    return Op{}(a, b);
+  }
+}
+
+template <template <typename> class Reducer, std::size_t... Dims,
+          execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank, ReductionOption... Options>
+auto reduce(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,
+            Options... /*options*/) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Reductions are currently only supported on CPU");
+  static_assert(((Dims < Rank) && ...),
+                "reduction dimension cannot be higher than tensor rank");
+
+  using Mode = Summation<Reducer<Elem>, Options...>;
+  using Op = typename Mode::reducer;
+  constexpr bool Squeeze = (std::is_same_v<Options, squeeze_t> or ...);
+  using ResultElementType = typename Op::result_type;
+
+  if constexpr (Rank == 0) {
+    return Tensor<ResultElementType, Dev, 0>(
+        Op::finalize(Op::push(Op::init(), t.value()), 1));
+  } else if constexpr (sizeof...(Dims) == 0 and kernels::Absorbing<Op>) {
+    const auto *in = t.data();
+    const bool absorbed = kernels::any_of(policy, t.size(), [in](auto i) {
+      return Op::push(Op::init(), in[i]) == Op::absorbing;
+    });
+    return Tensor<ResultElementType, Dev, 0>(
+        Op::finalize(absorbed ? Op::absorbing : Op::init(), t.size()));
+  } else {
+    constexpr auto mask = reduction_mask<Rank, Dims...>();
+    const auto extents = shape_extents(t);
+    auto result = reduction_result<ResultElementType, Squeeze, Dims...>(t);
+
+    kernels::reduce<Op, Mode::pairwise>(policy, t.data(), extents, mask,
+                                        result.data());
+    return result;
+  }
+}
+
+template <std::size_t... Dims, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank, typename... Options>
+auto mean_var(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,
+              Options... /*options*/) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Reductions are currently only supported on CPU");
+  static_assert(((Dims < Rank) && ...),
+                "reduction dimension cannot be higher than tensor rank");
+
+  using Op = kernels::MomentsReducer<Elem>;
+  using ResultElementType = typename kernels::VarianceReducer<Elem>::result_type;
+  constexpr bool Squeeze = sizeof...(Options) > 0;
+
+  auto mean = reduction_result<ResultElementType, Squeeze, Dims...>(t);
+  auto variance = reduction_result<ResultElementType, Squeeze, Dims...>(t);
+
+  if constexpr (Rank == 0) {
+    mean.data()[0] = static_cast<ResultElementType>(t.value());
+  } else {
+    auto moments = std::make_unique<typename Op::result_type[]>(mean.size());
+    kernels::reduce<Op>(policy, t.data(), shape_extents(t),
+                        reduction_mask<Rank, Dims...>(), moments.get());
+    for (std::size_t o = 0; o < mean.size(); ++o) {
+      mean.data()[o] = static_cast<ResultElementType>(moments[o].mean);
+      variance.data()[o] = static_cast<ResultElementType>(moments[o].variance);
+    }
+  }
+  return std::pair{std::move(mean), std::move(variance)};
+}
+
+// Index (and value) of the largest or smallest element along Axis, or of the
+// whole tensor as a flat index
+template <typename Order, bool WithValues, std::size_t... Axis,
+          execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank, typename... Options>
+auto arg_reduce(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,
+                Options... /*options*/) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Index reductions are currently only supported on CPU");
+  static_assert(sizeof...(Axis) <= 1, "index reductions take at most one axis");
+  static_assert(((Axis < Rank) && ...),
+                "reduction dimension cannot be higher than tensor rank");
+
+  constexpr bool Squeeze = sizeof...(Options) > 0;
+  const auto view = axis_view<Axis...>(shape_extents(t));
+  auto indices = reduction_result<std::size_t, Squeeze, Axis...>(t);
+
+  if constexpr (WithValues) {
+    auto values = reduction_result<Elem, Squeeze, Axis...>(t);
+    kernels::arg_select<Order>(policy, t.data(), view, values.data(),
+                               indices.data());
+    return std::pair{std::move(values), std::move(indices)};
+  } else {
+    kernels::arg_select<Order>(policy, t.data(), view,
+                               static_cast<Elem *>(nullptr), indices.data());
+    return indices;
+  }
+}
+
+// softmax or log_softmax along Axis, the last one by default
+template <bool Log, std::size_t... Axis, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+auto softmax(Policy &&policy, const Tensor<Elem, Dev, Rank> &t)
+    -> Tensor<Elem, Dev, Rank> {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Softmax is currently only supported on CPU");
+  static_assert(std::floating_point<Elem> or HalfFloat<Elem>,
+                "Softmax needs a floating point element type");
+  static_assert(Rank > 0, "Softmax needs at least one axis");
+  static_assert(sizeof...(Axis) <= 1, "Softmax takes at most one axis");
+  constexpr std::size_t axis =
+      sizeof...(Axis) == 0 ? Rank - 1 : (Axis + ... + 0);
+  static_assert(axis < Rank, "Softmax axis cannot be higher than tensor rank");
+
+  auto result = Tensor<Elem, Dev, Rank>(t.shape());
+  if (t.size() > 0) {
+    kernels::softmax<Log>(policy, t.data(),
+                          axis_view<axis>(shape_extents(t)), result.data());
+  }
+  return result;
+}
+
+// Inclusive scan along Axis, the last one by default
+template <template <typename> class Reducer, std::size_t... Axis,
+          execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+auto scan(Policy &&policy, const Tensor<Elem, Dev, Rank> &t) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Scans are currently only supported on CPU");
+  static_assert(Rank > 0, "Scans need at least one axis");
+  static_assert(sizeof...(Axis) <= 1, "Scans take at most one axis");
+  constexpr std::size_t axis =
+      sizeof...(Axis) == 0 ? Rank - 1 : (Axis + ... + 0);
+  static_assert(axis < Rank, "Scan axis cannot be higher than tensor rank");
+
+  using Op = Reducer<Elem>;
+  auto result = Tensor<typename Op::result_type, Dev, Rank>(t.shape());
+  if (t.size() > 0) {
+    kernels::scan<Op>(policy, t.data(), axis_view<axis>(shape_extents(t)),
+                      result.data());
+  }
+  return result;
+}
+
+// Distinct values of t in ascending order, with the kernel's positions
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+auto unique(Policy &&policy, const Tensor<Elem, Dev, Rank> &t) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Unique is currently only supported on CPU");
+  auto found = kernels::unique(policy, t.data(), t.size());
+  auto values = Tensor<Elem, Dev, 1>(found.size);
+  for (std::size_t u = 0; u < found.size; ++u) {
+    values.data()[u] = t.data()[found.first[u]];
+  }
+  return std::pair{std::move(values), std::move(found)};
+}
+
+template <typename Result>
+auto positions(const std::size_t *first, std::size_t count) -> Result {
+  auto result = Result(count);
+  std::copy(first, first + count, result.data());
+  return result;
+}
+
+// Lowest and highest non-NaN value of t, or (0, 1) when there is none
+template <typename Edge, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+auto value_range(Policy &&policy, const Tensor<Elem, Dev, Rank> &t)
+    -> std::pair<Edge, Edge> {
+  if (t.size() == 0) {
+    return {Edge{0}, Edge{1}};
+  }
+  const auto shape = std::array<std::size_t, 1>{t.size()};
+  const auto mask = std::array<bool, 1>{true};
+  Elem lo{};
+  Elem hi{};
+  kernels::reduce<kernels::MinReducer<Elem>>(policy, t.data(), shape, mask,
+                                             &lo);
+  kernels::reduce<kernels::MaxReducer<Elem>>(policy, t.data(), shape, mask,
+                                             &hi);
+  if (not(lo <= hi)) {
+    return {Edge{0}, Edge{1}};
+  }
+  return {static_cast<Edge>(lo), static_cast<Edge>(hi)};
+}
+
+// Histogram edges are double for integers and computed in the accumulator
+// type otherwise
+template <typename Elem>
+using histogram_edge_t =
+    std::conditional_t<std::is_integral_v<Elem>, double, accumulator_t<Elem>>;
+
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+auto histogram(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,
+               std::size_t bins, std::pair<histogram_edge_t<Elem>,
+                                           histogram_edge_t<Elem>> range) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Histograms are currently only supported on CPU");
+  using Edge = histogram_edge_t<Elem>;
+  auto [lo, hi] = range;
+  if (bins == 0) {
+    throw std::invalid_argument("Histogram: needs at least one bin");
+  }
+  if (not(lo <= hi) or not std::isfinite(lo) or not std::isfinite(hi)) {
+    throw std::invalid_argument(
+        std::format("Histogram: range [{}, {}] is not a finite interval",
+                    static_cast<double>(lo), static_cast<double>(hi)));
+  }
+  if (lo == hi) {
+    lo -= Edge{0.5};
+    hi += Edge{0.5};
+  }
+
+  auto edges = Tensor<Edge, Dev, 1>(bins + 1);
+  for (std::size_t b = 0; b < bins; ++b) {
+    edges.data()[b] =
+        lo + ((hi - lo) * static_cast<Edge>(b) / static_cast<Edge>(bins));
+  }
+  edges.data()[bins] = hi;
+
+  auto counts = Tensor<std::size_t, Dev, 1>(bins);
+  kernels::histogram(policy, t.data(), t.size(), edges.data(), bins,
+                     counts.data());
+  return std::pair{std::move(counts), std::move(edges)};
+}
+
+// Largest id plus one, after checking the ids against num_segments if given
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, typename Dev>
+auto segment_count(Policy &&policy, const Tensor<std::size_t, Dev, 1> &ids,
+                   std::optional<std::size_t> num_segments) -> std::size_t {
+  if (ids.size() == 0) {
+    return num_segments.value_or(0);
+  }
+  const auto highest = value_range<std::size_t>(policy, ids).second;
+  if (num_segments and highest >= *num_segments) {
+    throw std::invalid_argument(
+        std::format("Segment id {} is out of range for {} segments", highest,
+                    *num_segments));
+  }
+  return num_segments.value_or(highest + 1);
+}
+
+// Reduces the rows of values (its first axis) into segments
+template <template <typename> class Reducer, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+auto segment_reduce(Policy &&policy, const Tensor<Elem, Dev, Rank> &values,
+                    const Tensor<std::size_t, Dev, 1> &segment_ids,
+                    std::optional<std::size_t> num_segments) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Segment reductions are currently only supported on CPU");
+  static_assert(Rank > 0, "Segment reductions need at least one axis");
+  using Op = Reducer<Elem>;
+
+  auto extents = shape_extents(values);
+  if (segment_ids.size() != extents[0]) {
+    throw std::invalid_argument(
+        std::format("Segment reduction: {} segment ids for {} rows",
+                    segment_ids.size(), extents[0]));
+  }
+  const auto segments = segment_count(policy, segment_ids, num_segments);
+
+  const auto view = axis_view<0>(extents);
+  extents[0] = segments;
+  auto result =
+      Tensor<typename Op::result_type, Dev, Rank>(Shape<Rank>(extents));
+  if (result.size() > 0) {
+    kernels::segment_reduce<Op>(policy, values.data(), view,
+                                segment_ids.data(), segments, result.data());
+  }
+  return result;
+}
+
 consteval auto count_operands(const std::string_view eqn) {
   auto lhs = eqn.substr(0, eqn.find("->"));
   return std::ranges::count(lhs, ',') + 1;
@@ -383,6 +1278,48 @@ auto homogenize_operand(const Tensor<Elem, Dev, Rank> &t) {
   return homogenized;
 }
 
+// C = A B, I x J row major, with A stored I x K (K x I when TransA) and B
+// stored K x J (J x K when TransB), finished by the epilogue. Products with
+// a unit dimension go to the vector kernels: a vector operand is contiguous
+// whichever way it is read, and a transposed matrix times a vector is the
+// vector times the matrix as stored.
+template <bool TransA, bool TransB, typename Policy, typename T, typename TA,
+          typename TB, typename Epilogue = kernels::NoEpilogue>
+void matrix_product(Policy &&policy, std::size_t I, std::size_t J,
+                    std::size_t K, const TA *a, const TB *b, T *c,
+                    const Epilogue &epilogue = {}) {
+  if (J == 1) {
+    if constexpr (TransA) {
+      kernels::gevm(policy, K, I, b, a, I, c);
+    } else {
+      kernels::gemv(policy, I, K, a, K, b, c);
+    }
+  } else if (I == 1) {
+    if constexpr (TransB) {
+      kernels::gemv(policy, J, K, b, K, a, c);
+    } else {
+      kernels::gevm(policy, K, J, a, b, J, c);
+    }
+  } else if (K == 1 and std::is_same_v<Epilogue, kernels::NoEpilogue>) {
+    kernels::ger(policy, I, J, a, b, c, J, false);
+    return;
+  } else {
+    kernels::gemm(
+        policy, I, J, K,
+        kernels::MatrixView<TA>{a, TransA ? 1 : K, TransA ? I : 1},
+        kernels::MatrixView<TB>{b, TransB ? 1 : J, TransB ? K : 1}, c, J,
+        kernels::gemm_blocking<T>(), epilogue);
+    return;
+  }
+
+  // A single row or column, small enough to finish in a pass of its own
+  if constexpr (not std::is_same_v<Epilogue, kernels::NoEpilogue>) {
+    for (std::size_t i = 0; i < I; ++i) {
+      epilogue(i, 0, c + (i * J), J);
+    }
+  }
+}
+
 } // namespace detail
 
 // Copy Transform
@@ -404,20 +1341,60 @@ auto transform(const Tensor<Elem, Dev, Rank> &tensor, Fn &&fn) {
   }
 }
 
-REGISTER_BINARY_OP(add, plus, +)
-REGISTER_BINARY_OP(sub, minus, -)
-REGISTER_BINARY_OP(mul, multiplies, *)
-REGISTER_BINARY_OP(div, divides, /)
-REGISTER_BINARY_OP(gt, greater, >)
-REGISTER_BINARY_OP(gte, greater_equal, >=)
-REGISTER_BINARY_OP(lt, less, <)
-REGISTER_BINARY_OP(lte, less_equal, <=)
-REGISTER_BINARY_OP(eq, equal_to, ==)
-REGISTER_BINARY_OP(neq, not_equal_to, !=)
-
-// Copy Sort
-template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
-          typename Dev, std::size_t Rank>
+// Copy Transform with an execution policy
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank, typename Fn>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto transform(Policy &&policy, const Tensor<Elem, Dev, Rank> &tensor,
+               Fn &&fn) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Transform is currently only supported on CPU");
+
+  using ResultElementType = std::invoke_result_t<Fn, Elem>;
+
+  if constexpr (Rank == 0) {
+    return Tensor<ResultElementType, Dev, 0>(fn(tensor.value()));
+  } else {
+    auto result = Tensor<ResultElementType, Dev, Rank>(tensor.shape());
+    detail::transform_range(policy, tensor.data(), result.data(),
+                            tensor.size(), fn);
+    return result;
+  }
+}
+
+// Copy Cast
+template <Scalar To, template <typename, typename, std::size_t> class Tensor,
+          Scalar Elem, typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto cast(const Tensor<Elem, Dev, Rank> &tensor) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Cast is currently only supported on CPU");
+
+  if constexpr (Rank == 0) {
+    return Tensor<To, Dev, 0>(
+        static_cast<To>(static_cast<accumulator_t<Elem>>(tensor.value())));
+  } else {
+    auto result = Tensor<To, Dev, Rank>(tensor.shape());
+    kernels::convert(tensor.data(), result.data(), tensor.size());
+    return result;
+  }
+}
+
+REGISTER_BINARY_OP(add, plus, +)
+REGISTER_BINARY_OP(sub, minus, -)
+REGISTER_BINARY_OP(mul, multiplies, *)
+REGISTER_BINARY_OP(div, divides, /)
+REGISTER_BINARY_OP(gt, greater, >)
+REGISTER_BINARY_OP(gte, greater_equal, >=)
+REGISTER_BINARY_OP(lt, less, <)
+REGISTER_BINARY_OP(lte, less_equal, <=)
+REGISTER_BINARY_OP(eq, equal_to, ==)
+REGISTER_BINARY_OP(neq, not_equal_to, !=)
+
+// Copy Sort
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
   requires VenusTensor<Tensor<Elem, Dev, Rank>>
 auto sort(const Tensor<Elem, Dev, Rank> &tensor) {
   static_assert(std::is_same_v<Dev, Device::CPU>,
@@ -445,27 +1422,63 @@ auto equal(const Tensor<Elem1, Dev1, Rank1> &t1,
   }
 }
 
-// Inner product
+// Inner product, blocked so that every policy gives the same result. Takes
+// a summation mode like sum, e.g. inner(x, y, kahan).
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          typename Dev1, Scalar Elem2, typename Dev2, std::size_t Rank1,
+          std::size_t Rank2, SummationMode... Modes>
+  requires VenusTensor<Tensor<Elem1, Dev1, Rank1>> &&
+           VenusTensor<Tensor<Elem2, Dev2, Rank2>>
+auto inner(Policy &&policy, const Tensor<Elem1, Dev1, Rank1> &t1,
+           const Tensor<Elem2, Dev2, Rank2> &t2, Modes... /*modes*/) {
+  static_assert(std::is_same_v<Dev1, Device::CPU> and
+                    std::is_same_v<Dev2, Device::CPU>,
+                "Inner product is currently only supported on CPU");
+  using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  using AccumulatorType = accumulator_t<ResultElementType>;
+  using Mode =
+      detail::Summation<kernels::SumReducer<AccumulatorType>, Modes...>;
+  if (t1.size() != t2.size()) {
+    throw std::invalid_argument(
+        std::format("Inner product size mismatch: {} and {}", t1.size(),
+                    t2.size()));
+  }
+  const auto product =
+      kernels::dot<typename Mode::reducer, Mode::pairwise>(
+          policy, t1.data(), t2.data(), t1.size());
+  return Tensor<ResultElementType, Dev1, 0>(
+      static_cast<ResultElementType>(product));
+}
+
 template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
           typename Dev1, Scalar Elem2, typename Dev2, std::size_t Rank1,
-          std::size_t Rank2>
+          std::size_t Rank2, SummationMode... Modes>
   requires VenusTensor<Tensor<Elem1, Dev1, Rank1>> &&
            VenusTensor<Tensor<Elem2, Dev2, Rank2>>
 auto inner(const Tensor<Elem1, Dev1, Rank1> &t1,
-           const Tensor<Elem2, Dev2, Rank2> &t2) {
-  using ResultElementType = std::common_type_t<Elem1, Elem2>;
-  auto product =
-      std::inner_product(t1.begin(), t1.end(), t2.begin(), ResultElementType{});
-  return Tensor<ResultElementType, Dev1, 0>(product);
+           const Tensor<Elem2, Dev2, Rank2> &t2, Modes... modes) {
+  return inner(execution::seq, t1, t2, modes...);
 }
 
 // Dot product
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          typename Dev1, Scalar Elem2, typename Dev2, SummationMode... Modes>
+  requires VenusTensor<Tensor<Elem1, Dev1, 1>> &&
+           VenusTensor<Tensor<Elem2, Dev2, 1>>
+auto dot(Policy &&policy, const Tensor<Elem1, Dev1, 1> &t1,
+         const Tensor<Elem2, Dev2, 1> &t2, Modes... modes) {
+  return inner(policy, t1, t2, modes...);
+}
+
 template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
-          typename Dev1, Scalar Elem2, typename Dev2>
+          typename Dev1, Scalar Elem2, typename Dev2, SummationMode... Modes>
   requires VenusTensor<Tensor<Elem1, Dev1, 1>> &&
            VenusTensor<Tensor<Elem2, Dev2, 1>>
-auto dot(const Tensor<Elem1, Dev1, 1> &t1, const Tensor<Elem2, Dev2, 1> &t2) {
-  return inner(t1, t2);
+auto dot(const Tensor<Elem1, Dev1, 1> &t1, const Tensor<Elem2, Dev2, 1> &t2,
+         Modes... modes) {
+  return inner(execution::seq, t1, t2, modes...);
 }
 
 // Out-Of-Place Arange
@@ -506,42 +1519,672 @@ auto fill(const Tensor<Elem, Dev, Rank> &tensor, Idx i) {
   return result;
 }
 
-// Matrix Multiplication (2D)
+// Matrix Multiplication (2D), as a packed, cache-blocked GEMM computed in
+// the accumulation type (fp32 for half precision). Products with a unit
+// dimension go to the matrix-vector and outer product kernels instead.
+// trans_a and trans_b multiply by the transposes of the operands as stored.
+// Parallel policies split it across the thread pool once it is large
+// enough to pay for that; the result is the same on every policy.
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev, MatMulOption... Options>
+  requires VenusTensor<Tensor<Elem1, Dev, 2>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>>
+auto mm(Policy &&policy, const Tensor<Elem1, Dev, 2> &t1,
+        const Tensor<Elem2, Dev, 2> &t2, Options... /*options*/) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "MatMul is currently only supported on CPU");
+
+  using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  constexpr bool TransA = (std::is_same_v<Options, trans_a_t> or ...);
+  constexpr bool TransB = (std::is_same_v<Options, trans_b_t> or ...);
+
+  const auto I = t1.shape()[TransA ? 1 : 0];
+  const auto K = t1.shape()[TransA ? 0 : 1];
+  const auto K2 = t2.shape()[TransB ? 1 : 0];
+  const auto J = t2.shape()[TransB ? 0 : 1];
+
+  if (K != K2) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch between tensors in matrix mul: t1 has "
+                    "shape {}{}, whereas t2 has shape {}{}.",
+                    t1.shape(), TransA ? " (transposed)" : "", t2.shape(),
+                    TransB ? " (transposed)" : ""));
+  }
+
+  using AccumulatorType = accumulator_t<ResultElementType>;
+
+  auto t3 = Tensor<AccumulatorType, Dev, 2>(I, J);
+  detail::matrix_product<TransA, TransB>(policy, I, J, K, t1.data(),
+                                         t2.data(), t3.data());
+
+  if constexpr (std::is_same_v<AccumulatorType, ResultElementType>) {
+    return t3;
+  } else {
+    return cast<ResultElementType>(t3);
+  }
+}
+
 template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
-          Scalar Elem2, typename Dev>
+          Scalar Elem2, typename Dev, MatMulOption... Options>
   requires VenusTensor<Tensor<Elem1, Dev, 2>> &&
            VenusTensor<Tensor<Elem2, Dev, 2>>
-auto mm(const Tensor<Elem1, Dev, 2> &t1, const Tensor<Elem2, Dev, 2> &t2) {
+auto mm(const Tensor<Elem1, Dev, 2> &t1, const Tensor<Elem2, Dev, 2> &t2,
+        Options... options) {
+  return mm(execution::seq, t1, t2, options...);
+}
+
+// input + alpha (t1 t2), with the scale and the addition applied to every
+// tile of the product as it completes rather than in passes of their own
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, Scalar Elem3, typename Dev, Scalar Alpha,
+          MatMulOption... Options>
+  requires VenusTensor<Tensor<Elem1, Dev, 2>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>> &&
+           VenusTensor<Tensor<Elem3, Dev, 2>>
+auto addmm(Policy &&policy, const Tensor<Elem1, Dev, 2> &input,
+           const Tensor<Elem2, Dev, 2> &t1, const Tensor<Elem3, Dev, 2> &t2,
+           Alpha alpha, Options... /*options*/) {
   static_assert(std::is_same_v<Dev, Device::CPU>,
                 "MatMul is currently only supported on CPU");
 
+  using ResultElementType = std::common_type_t<Elem1, Elem2, Elem3>;
+  using AccumulatorType = accumulator_t<ResultElementType>;
+  constexpr bool TransA = (std::is_same_v<Options, trans_a_t> or ...);
+  constexpr bool TransB = (std::is_same_v<Options, trans_b_t> or ...);
+
+  const auto I = t1.shape()[TransA ? 1 : 0];
+  const auto K = t1.shape()[TransA ? 0 : 1];
+  const auto K2 = t2.shape()[TransB ? 1 : 0];
+  const auto J = t2.shape()[TransB ? 0 : 1];
+
+  if (K != K2) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch between tensors in matrix mul: t1 has "
+                    "shape {}{}, whereas t2 has shape {}{}.",
+                    t1.shape(), TransA ? " (transposed)" : "", t2.shape(),
+                    TransB ? " (transposed)" : ""));
+  }
+  if (input.shape() != Shape<2>(I, J)) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch in addmm: the input has shape {}, "
+                    "whereas the product has shape {}.",
+                    input.shape(), Shape<2>(I, J)));
+  }
+
+  auto result = Tensor<AccumulatorType, Dev, 2>(I, J);
+  detail::matrix_product<TransA, TransB>(
+      policy, I, J, K, t1.data(), t2.data(), result.data(),
+      kernels::GemmEpilogue<AccumulatorType, AccumulatorType, Elem1>{
+          .scale = static_cast<AccumulatorType>(alpha),
+          .residual = input.data(),
+          .ldr = J});
+
+  if constexpr (std::is_same_v<AccumulatorType, ResultElementType>) {
+    return result;
+  } else {
+    return cast<ResultElementType>(result);
+  }
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, Scalar Elem3, typename Dev, Scalar Alpha,
+          MatMulOption... Options>
+  requires VenusTensor<Tensor<Elem1, Dev, 2>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>> &&
+           VenusTensor<Tensor<Elem3, Dev, 2>>
+auto addmm(const Tensor<Elem1, Dev, 2> &input, const Tensor<Elem2, Dev, 2> &t1,
+           const Tensor<Elem3, Dev, 2> &t2, Alpha alpha, Options... options) {
+  return addmm(execution::seq, input, t1, t2, alpha, options...);
+}
+
+namespace detail {
+
+// activation(x W^T + bias) + residual over the last dimension of x, with a
+// null residual for none
+template <typename Result, typename Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, Scalar Elem3, typename Dev, std::size_t Rank,
+          typename Residual>
+auto linear(Policy &&policy, const Tensor<Elem1, Dev, Rank> &x,
+            const Tensor<Elem2, Dev, 2> &weight,
+            const Tensor<Elem3, Dev, 1> &bias, Activation activation,
+            const Residual *residual) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Linear is currently only supported on CPU");
+
+  using AccumulatorType = accumulator_t<Result>;
+
+  const auto [N, K] = weight.shape();
+  if (x.shape()[Rank - 1] != K) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch in linear: the input has shape {}, "
+                    "whereas the weight has shape {}.",
+                    x.shape(), weight.shape()));
+  }
+  if (bias.shape()[0] != N) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch in linear: the weight has shape {}, "
+                    "whereas the bias has shape {}.",
+                    weight.shape(), bias.shape()));
+  }
+
+  std::array<std::size_t, Rank> out_dims{};
+  for (std::size_t d = 0; d < Rank; ++d) {
+    out_dims[d] = x.shape()[d];
+  }
+  out_dims[Rank - 1] = N;
+
+  auto result = Tensor<AccumulatorType, Dev, Rank>(Shape<Rank>(out_dims));
+  detail::matrix_product<false, true>(
+      policy, x.size() / K, N, K, x.data(), weight.data(), result.data(),
+      kernels::GemmEpilogue<AccumulatorType, Elem3, Residual>{
+          .bias = bias.data(),
+          .residual = residual,
+          .ldr = N,
+          .activation = activation});
+
+  if constexpr (std::is_same_v<AccumulatorType, Result>) {
+    return result;
+  } else {
+    return cast<Result>(result);
+  }
+}
+
+} // namespace detail
+
+// Linear layer, activation(x W^T + bias), for x of shape [..., in] and a
+// weight stored [out, in] as in PyTorch, read in place. The bias and the
+// activation are applied to every tile of the product as it completes, so
+// the output is written once.
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, Scalar Elem3, typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem1, Dev, Rank>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>> &&
+           VenusTensor<Tensor<Elem3, Dev, 1>>
+auto linear(Policy &&policy, const Tensor<Elem1, Dev, Rank> &x,
+            const Tensor<Elem2, Dev, 2> &weight,
+            const Tensor<Elem3, Dev, 1> &bias,
+            Activation activation = Activation::none) {
+  return detail::linear<std::common_type_t<Elem1, Elem2, Elem3>>(
+      policy, x, weight, bias, activation,
+      static_cast<const Elem1 *>(nullptr));
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, Scalar Elem3, typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem1, Dev, Rank>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>> &&
+           VenusTensor<Tensor<Elem3, Dev, 1>>
+auto linear(const Tensor<Elem1, Dev, Rank> &x,
+            const Tensor<Elem2, Dev, 2> &weight,
+            const Tensor<Elem3, Dev, 1> &bias,
+            Activation activation = Activation::none) {
+  return linear(execution::seq, x, weight, bias, activation);
+}
+
+// Linear layer with a residual connection, activation(x W^T + bias) +
+// residual, the residual having the shape of the output
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, Scalar Elem3, Scalar Elem4, typename Dev,
+          std::size_t Rank>
+  requires VenusTensor<Tensor<Elem1, Dev, Rank>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>> &&
+           VenusTensor<Tensor<Elem3, Dev, 1>> &&
+           VenusTensor<Tensor<Elem4, Dev, Rank>>
+auto linear(Policy &&policy, const Tensor<Elem1, Dev, Rank> &x,
+            const Tensor<Elem2, Dev, 2> &weight,
+            const Tensor<Elem3, Dev, 1> &bias, Activation activation,
+            const Tensor<Elem4, Dev, Rank> &residual) {
+  bool matches = residual.shape()[Rank - 1] == weight.shape()[0];
+  for (std::size_t d = 0; d + 1 < Rank; ++d) {
+    matches = matches and residual.shape()[d] == x.shape()[d];
+  }
+  if (not matches) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch in linear: the input has shape {} and "
+                    "the weight {}, whereas the residual has shape {}.",
+                    x.shape(), weight.shape(), residual.shape()));
+  }
+  return detail::linear<std::common_type_t<Elem1, Elem2, Elem3, Elem4>>(
+      policy, x, weight, bias, activation, residual.data());
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, Scalar Elem3, Scalar Elem4, typename Dev,
+          std::size_t Rank>
+  requires VenusTensor<Tensor<Elem1, Dev, Rank>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>> &&
+           VenusTensor<Tensor<Elem3, Dev, 1>> &&
+           VenusTensor<Tensor<Elem4, Dev, Rank>>
+auto linear(const Tensor<Elem1, Dev, Rank> &x,
+            const Tensor<Elem2, Dev, 2> &weight,
+            const Tensor<Elem3, Dev, 1> &bias, Activation activation,
+            const Tensor<Elem4, Dev, Rank> &residual) {
+  return linear(execution::seq, x, weight, bias, activation, residual);
+}
+
+// Matrix-Vector Multiplication, [I, K] by [K] into [I]
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev>
+  requires VenusTensor<Tensor<Elem1, Dev, 2>> &&
+           VenusTensor<Tensor<Elem2, Dev, 1>>
+auto mv(Policy &&policy, const Tensor<Elem1, Dev, 2> &matrix,
+        const Tensor<Elem2, Dev, 1> &vector) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "MatVec is currently only supported on CPU");
+
+  using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  using AccumulatorType = accumulator_t<ResultElementType>;
+
+  const auto [I, K] = matrix.shape();
+  if (K != vector.shape()[0]) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch in matrix-vector mul: the matrix has "
+                    "shape {}, whereas the vector has shape {}.",
+                    matrix.shape(), vector.shape()));
+  }
+
+  auto result = Tensor<AccumulatorType, Dev, 1>(I);
+  kernels::gemv(policy, I, K, matrix.data(), K, vector.data(), result.data());
+
+  if constexpr (std::is_same_v<AccumulatorType, ResultElementType>) {
+    return result;
+  } else {
+    return cast<ResultElementType>(result);
+  }
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev>
+  requires VenusTensor<Tensor<Elem1, Dev, 2>> &&
+           VenusTensor<Tensor<Elem2, Dev, 1>>
+auto mv(const Tensor<Elem1, Dev, 2> &matrix,
+        const Tensor<Elem2, Dev, 1> &vector) {
+  return mv(execution::seq, matrix, vector);
+}
+
+// Vector-Matrix Multiplication, [K] by [K, J] into [J]
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev>
+  requires VenusTensor<Tensor<Elem1, Dev, 1>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>>
+auto vm(Policy &&policy, const Tensor<Elem1, Dev, 1> &vector,
+        const Tensor<Elem2, Dev, 2> &matrix) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "VecMat is currently only supported on CPU");
+
+  using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  using AccumulatorType = accumulator_t<ResultElementType>;
+
+  const auto [K, J] = matrix.shape();
+  if (K != vector.shape()[0]) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch in vector-matrix mul: the vector has "
+                    "shape {}, whereas the matrix has shape {}.",
+                    vector.shape(), matrix.shape()));
+  }
+
+  auto result = Tensor<AccumulatorType, Dev, 1>(J);
+  kernels::gevm(policy, K, J, vector.data(), matrix.data(), J, result.data());
+
+  if constexpr (std::is_same_v<AccumulatorType, ResultElementType>) {
+    return result;
+  } else {
+    return cast<ResultElementType>(result);
+  }
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev>
+  requires VenusTensor<Tensor<Elem1, Dev, 1>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>>
+auto vm(const Tensor<Elem1, Dev, 1> &vector,
+        const Tensor<Elem2, Dev, 2> &matrix) {
+  return vm(execution::seq, vector, matrix);
+}
+
+// Outer Product, [I] by [J] into [I, J]; ger is the BLAS name for it
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev>
+  requires VenusTensor<Tensor<Elem1, Dev, 1>> &&
+           VenusTensor<Tensor<Elem2, Dev, 1>>
+auto outer(Policy &&policy, const Tensor<Elem1, Dev, 1> &t1,
+           const Tensor<Elem2, Dev, 1> &t2) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Outer is currently only supported on CPU");
+
   using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  using AccumulatorType = accumulator_t<ResultElementType>;
+
+  const auto I = t1.shape()[0];
+  const auto J = t2.shape()[0];
+
+  auto result = Tensor<AccumulatorType, Dev, 2>(I, J);
+  kernels::ger(policy, I, J, t1.data(), t2.data(), result.data(), J, false);
+
+  if constexpr (std::is_same_v<AccumulatorType, ResultElementType>) {
+    return result;
+  } else {
+    return cast<ResultElementType>(result);
+  }
+}
 
-  const auto [I, K] = t1.shape();
-  const auto [K2, J] = t2.shape();
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev>
+  requires VenusTensor<Tensor<Elem1, Dev, 1>> &&
+           VenusTensor<Tensor<Elem2, Dev, 1>>
+auto outer(const Tensor<Elem1, Dev, 1> &t1, const Tensor<Elem2, Dev, 1> &t2) {
+  return outer(execution::seq, t1, t2);
+}
+
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev>
+  requires VenusTensor<Tensor<Elem1, Dev, 1>> &&
+           VenusTensor<Tensor<Elem2, Dev, 1>>
+auto ger(Policy &&policy, const Tensor<Elem1, Dev, 1> &t1,
+         const Tensor<Elem2, Dev, 1> &t2) {
+  return outer(policy, t1, t2);
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev>
+  requires VenusTensor<Tensor<Elem1, Dev, 1>> &&
+           VenusTensor<Tensor<Elem2, Dev, 1>>
+auto ger(const Tensor<Elem1, Dev, 1> &t1, const Tensor<Elem2, Dev, 1> &t2) {
+  return outer(execution::seq, t1, t2);
+}
+
+// Batched Matrix Multiplication: the last two dimensions are multiplied as
+// matrices, and the leading (batch) dimensions broadcast as in NumPy, so a
+// [B, H, S, D] tensor multiplies a [D, E] weight or a [B, 1, D, S] one
+// without copies. trans_a and trans_b transpose the matrices of every
+// batch as stored. Parallel policies schedule the batch and the tiles of
+// every product together.
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev, std::size_t Rank1, std::size_t Rank2,
+          MatMulOption... Options>
+  requires VenusTensor<Tensor<Elem1, Dev, Rank1>> &&
+           VenusTensor<Tensor<Elem2, Dev, Rank2>> && (Rank1 >= 2) &&
+           (Rank2 >= 2)
+auto matmul(Policy &&policy, const Tensor<Elem1, Dev, Rank1> &t1,
+            const Tensor<Elem2, Dev, Rank2> &t2, Options... /*options*/) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "MatMul is currently only supported on CPU");
+
+  using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  using AccumulatorType = accumulator_t<ResultElementType>;
+  constexpr auto RankOut = std::max(Rank1, Rank2);
+  constexpr auto Batch1 = Rank1 - 2;
+  constexpr auto Batch2 = Rank2 - 2;
+  constexpr auto BatchOut = RankOut - 2;
+  constexpr bool TransA = (std::is_same_v<Options, trans_a_t> or ...);
+  constexpr bool TransB = (std::is_same_v<Options, trans_b_t> or ...);
+
+  const auto &s1 = t1.shape();
+  const auto &s2 = t2.shape();
+  const auto I = s1[TransA ? Rank1 - 1 : Rank1 - 2];
+  const auto K = s1[TransA ? Rank1 - 2 : Rank1 - 1];
+  const auto K2 = s2[TransB ? Rank2 - 1 : Rank2 - 2];
+  const auto J = s2[TransB ? Rank2 - 2 : Rank2 - 1];
 
   if (K != K2) {
     throw std::invalid_argument(
         std::format("Shape mismatch between tensors in matrix mul: t1 has "
-                    "shape {}, whereas t2 has shape {}.",
+                    "shape {}{}, whereas t2 has shape {}{}.",
+                    s1, TransA ? " (transposed)" : "", s2,
+                    TransB ? " (transposed)" : ""));
+  }
+
+  // Batch dimensions, right aligned, with the batch strides of both operands
+  // (zero where they broadcast)
+  std::array<std::size_t, RankOut> out_dims{};
+  std::array<std::size_t, BatchOut> stride1{};
+  std::array<std::size_t, BatchOut> stride2{};
+  auto step1 = I * K;
+  auto step2 = K * J;
+  for (auto d = BatchOut; d-- > 0;) {
+    const auto d1 = d >= BatchOut - Batch1 ? s1[d - (BatchOut - Batch1)] : 1;
+    const auto d2 = d >= BatchOut - Batch2 ? s2[d - (BatchOut - Batch2)] : 1;
+    if (d1 != d2 and d1 != 1 and d2 != 1) {
+      throw std::invalid_argument(
+          std::format("Batch dimensions are not broadcastable in matrix mul: "
+                      "t1 has shape {}, whereas t2 has shape {}.",
+                      s1, s2));
+    }
+    out_dims[d] = std::max(d1, d2);
+    stride1[d] = d1 == 1 ? 0 : step1;
+    stride2[d] = d2 == 1 ? 0 : step2;
+    step1 *= d1;
+    step2 *= d2;
+  }
+  out_dims[RankOut - 2] = I;
+  out_dims[RankOut - 1] = J;
+
+  const auto batch =
+      std::accumulate(out_dims.begin(), out_dims.begin() + BatchOut,
+                      std::size_t{1}, std::multiplies<>());
+  auto offsets1 = std::make_unique<std::size_t[]>(batch);
+  auto offsets2 = std::make_unique<std::size_t[]>(batch);
+  for (std::size_t b = 0; b < batch; ++b) {
+    auto rest = b;
+    for (auto d = BatchOut; d-- > 0;) {
+      const auto idx = rest % out_dims[d];
+      rest /= out_dims[d];
+      offsets1[b] += idx * stride1[d];
+      offsets2[b] += idx * stride2[d];
+    }
+  }
+
+  auto t3 = Tensor<AccumulatorType, Dev, RankOut>(Shape<RankOut>(out_dims));
+  const auto view1 =
+      kernels::MatrixView<Elem1>{t1.data(), TransA ? 1 : K, TransA ? I : 1};
+  const auto view2 =
+      kernels::MatrixView<Elem2>{t2.data(), TransB ? 1 : J, TransB ? K : 1};
+  // Many tiny square products go one per SIMD lane instead of one per GEMM
+  const bool small =
+      batch > 1 and I == J and J == K and
+      kernels::dispatch_small_matrix(I, [&](auto size) {
+        kernels::small_matmul<decltype(size)::value>(
+            policy, batch,
+            [&](std::size_t b) {
+              return kernels::MatrixView<Elem1>{view1.data + offsets1[b],
+                                                view1.row_stride,
+                                                view1.col_stride};
+            },
+            [&](std::size_t b) {
+              return kernels::MatrixView<Elem2>{view2.data + offsets2[b],
+                                                view2.row_stride,
+                                                view2.col_stride};
+            },
+            t3.data());
+      });
+  if (not small) {
+    kernels::gemm_batched(policy, batch, I, J, K, view1, offsets1.get(), view2,
+                          offsets2.get(), t3.data(), J, I * J,
+                          kernels::gemm_blocking<AccumulatorType>());
+  }
+
+  if constexpr (std::is_same_v<AccumulatorType, ResultElementType>) {
+    return t3;
+  } else {
+    return cast<ResultElementType>(t3);
+  }
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev, std::size_t Rank1, std::size_t Rank2,
+          MatMulOption... Options>
+  requires VenusTensor<Tensor<Elem1, Dev, Rank1>> &&
+           VenusTensor<Tensor<Elem2, Dev, Rank2>> && (Rank1 >= 2) &&
+           (Rank2 >= 2)
+auto matmul(const Tensor<Elem1, Dev, Rank1> &t1,
+            const Tensor<Elem2, Dev, Rank2> &t2, Options... options) {
+  return matmul(execution::seq, t1, t2, options...);
+}
+
+// Batched Matrix Multiplication of [B, I, K] by [B, K, J], batch for batch
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev, MatMulOption... Options>
+  requires VenusTensor<Tensor<Elem1, Dev, 3>> &&
+           VenusTensor<Tensor<Elem2, Dev, 3>>
+auto bmm(Policy &&policy, const Tensor<Elem1, Dev, 3> &t1,
+         const Tensor<Elem2, Dev, 3> &t2, Options... options) {
+  if (t1.shape()[0] != t2.shape()[0]) {
+    throw std::invalid_argument(
+        std::format("Batch size mismatch in batched matrix mul: t1 has shape "
+                    "{}, whereas t2 has shape {}.",
                     t1.shape(), t2.shape()));
   }
+  return matmul(policy, t1, t2, options...);
+}
 
-  auto t3 = Tensor<ResultElementType, Dev, 2>(I, J);
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev, MatMulOption... Options>
+  requires VenusTensor<Tensor<Elem1, Dev, 3>> &&
+           VenusTensor<Tensor<Elem2, Dev, 3>>
+auto bmm(const Tensor<Elem1, Dev, 3> &t1, const Tensor<Elem2, Dev, 3> &t2,
+         Options... options) {
+  return bmm(execution::seq, t1, t2, options...);
+}
 
-  // TODO: This is optimized for row major layout
-  for (std::size_t i = 0; i < I; i++) {
-    for (std::size_t k = 0; k < K; k++) {
-      if (t1[i, k] == 0) {
-        continue;
-      }
-      for (std::size_t j = 0; j < J; j++) {
-        t3[i, j] += t1[i, k] * t2[k, j];
-      }
+// Determinants of a batch of [N, D, D] matrices, D up to
+// kernels::max_small_matrix, with each SIMD lane taking a different matrix
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev>
+  requires VenusTensor<Tensor<Elem, Dev, 3>>
+auto det(Policy &&policy, const Tensor<Elem, Dev, 3> &t)
+    -> Tensor<Elem, Dev, 1> {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Det is currently only supported on CPU");
+
+  const auto &shape = t.shape();
+  auto result = Tensor<Elem, Dev, 1>(Shape<1>(shape[0]));
+  if (shape[1] != shape[2] or
+      not kernels::dispatch_small_matrix(shape[1], [&](auto size) {
+        kernels::small_det<decltype(size)::value, accumulator_t<Elem>>(
+            policy, shape[0], t.data(), result.data());
+      })) {
+    throw std::invalid_argument(
+        std::format("Det needs square matrices of size at most {}, got a "
+                    "tensor of shape {}.",
+                    kernels::max_small_matrix, shape));
+  }
+  return result;
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev>
+  requires VenusTensor<Tensor<Elem, Dev, 3>>
+auto det(const Tensor<Elem, Dev, 3> &t) -> Tensor<Elem, Dev, 1> {
+  return det(execution::seq, t);
+}
+
+// Inverses of a batch of [N, D, D] matrices, D up to
+// kernels::max_small_matrix. Singular matrices give infinities or NaNs.
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev>
+  requires VenusTensor<Tensor<Elem, Dev, 3>>
+auto inverse(Policy &&policy, const Tensor<Elem, Dev, 3> &t)
+    -> Tensor<Elem, Dev, 3> {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Inverse is currently only supported on CPU");
+  static_assert(std::floating_point<Elem> or HalfFloat<Elem>,
+                "Inverse needs a floating point element type");
+
+  const auto &shape = t.shape();
+  auto result = Tensor<Elem, Dev, 3>(shape);
+  if (shape[1] != shape[2] or
+      not kernels::dispatch_small_matrix(shape[1], [&](auto size) {
+        kernels::small_inverse<decltype(size)::value, accumulator_t<Elem>>(
+            policy, shape[0], t.data(), result.data());
+      })) {
+    throw std::invalid_argument(
+        std::format("Inverse needs square matrices of size at most {}, got a "
+                    "tensor of shape {}.",
+                    kernels::max_small_matrix, shape));
+  }
+  return result;
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev>
+  requires VenusTensor<Tensor<Elem, Dev, 3>>
+auto inverse(const Tensor<Elem, Dev, 3> &t) -> Tensor<Elem, Dev, 3> {
+  return inverse(execution::seq, t);
+}
+
+// Row n of points [N, V] transformed by matrix n of [N, D, D], or by the
+// only one of [1, D, D]. Rows of V = D - 1 are points in homogeneous
+// coordinates (a 4 x 4 transform of 3D points, with the divide by w), and
+// rows of V = D are transformed as they are.
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev>
+  requires VenusTensor<Tensor<Elem1, Dev, 3>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>>
+auto transform_points(Policy &&policy, const Tensor<Elem1, Dev, 3> &matrices,
+                      const Tensor<Elem2, Dev, 2> &points) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Transform points is currently only supported on CPU");
+  using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  static_assert(std::floating_point<ResultElementType> or
+                    HalfFloat<ResultElementType>,
+                "Transform points needs a floating point element type");
+  using AccumulatorType = accumulator_t<ResultElementType>;
+
+  const auto &ms = matrices.shape();
+  const auto &ps = points.shape();
+  const auto N = ps[0];
+  const auto V = ps[1];
+  const auto D = ms[1];
+  if (ms[1] != ms[2] or (ms[0] != N and ms[0] != 1) or
+      (V != D and V + 1 != D)) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch between tensors in transform points: "
+                    "matrices have shape {}, whereas points have shape {}.",
+                    ms, ps));
+  }
+
+  auto result = Tensor<ResultElementType, Dev, 2>(ps);
+  const auto stride = ms[0] == 1 ? 0 : D * D;
+  const bool supported = kernels::dispatch_small_matrix(D, [&](auto size) {
+    constexpr auto Size = decltype(size)::value;
+    if (V == Size) {
+      kernels::small_transform<Size, Size, AccumulatorType>(
+          policy, N, matrices.data(), stride, points.data(), result.data());
+    } else if constexpr (Size > 1) {
+      kernels::small_transform<Size, Size - 1, AccumulatorType>(
+          policy, N, matrices.data(), stride, points.data(), result.data());
     }
+  });
+  if (not supported) {
+    throw std::invalid_argument(
+        std::format("Transform points needs matrices of size at most {}, got "
+                    "a tensor of shape {}.",
+                    kernels::max_small_matrix, ms));
   }
+  return result;
+}
 
-  return t3;
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
+          Scalar Elem2, typename Dev>
+  requires VenusTensor<Tensor<Elem1, Dev, 3>> &&
+           VenusTensor<Tensor<Elem2, Dev, 2>>
+auto transform_points(const Tensor<Elem1, Dev, 3> &matrices,
+                      const Tensor<Elem2, Dev, 2> &points) {
+  return transform_points(execution::seq, matrices, points);
 }
 
 template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
@@ -659,72 +2302,560 @@ auto where(T1 &&predicate, T2 &&true_tensor, T3 &&false_tensor) {
   }
 }
 
+// Fused compare + select: where_gt(x, 3, x, y) == where(x > 3, x, y), without
+// materializing the boolean mask
+REGISTER_FUSED_WHERE(where_gt, greater)
+REGISTER_FUSED_WHERE(where_gte, greater_equal)
+REGISTER_FUSED_WHERE(where_lt, less)
+REGISTER_FUSED_WHERE(where_lte, less_equal)
+REGISTER_FUSED_WHERE(where_eq, equal_to)
+REGISTER_FUSED_WHERE(where_neq, not_equal_to)
+
+// Fused multiply-add and linear interpolation, with broadcasting and in one
+// pass: fma(a, b, c) == a * b + c, lerp(a, b, t) == a + t * (b - a)
+REGISTER_FUSED_TERNARY_OP(fma, fused_multiply_add)
+REGISTER_FUSED_TERNARY_OP(lerp, linear_interpolate)
+
+// In-Place y = alpha * x + y
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor,
+          Scalar Alpha, Scalar ElemX, Scalar ElemY, typename Dev,
+          std::size_t Rank>
+  requires VenusTensor<Tensor<ElemX, Dev, Rank>> &&
+           VenusTensor<Tensor<ElemY, Dev, Rank>>
+void axpy(Policy &&policy, Alpha alpha, const Tensor<ElemX, Dev, Rank> &x,
+          Tensor<ElemY, Dev, Rank> &y) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "BLAS ops are currently only supported on CPU");
+  detail::require_same_shape(x, y);
+  detail::require_unique(y);
+
+  using AccumulatorType =
+      accumulator_t<std::common_type_t<Alpha, ElemX, ElemY>>;
+  const auto a = static_cast<AccumulatorType>(alpha);
+  const auto *x_ptr = x.data();
+  auto *y_ptr = y.data();
+
+  auto body = [&](std::size_t i) {
+    y_ptr[i] = static_cast<ElemY>(
+        detail::multiply_add(a, static_cast<AccumulatorType>(x_ptr[i]),
+                             static_cast<AccumulatorType>(y_ptr[i])));
+  };
+  detail::for_each_index(policy, y.size(), body);
+}
+
+template <template <typename, typename, std::size_t> class Tensor,
+          Scalar Alpha, Scalar ElemX, Scalar ElemY, typename Dev,
+          std::size_t Rank>
+  requires VenusTensor<Tensor<ElemX, Dev, Rank>> &&
+           VenusTensor<Tensor<ElemY, Dev, Rank>>
+void axpy(Alpha alpha, const Tensor<ElemX, Dev, Rank> &x,
+          Tensor<ElemY, Dev, Rank> &y) {
+  axpy(execution::unseq, alpha, x, y);
+}
+
+// In-Place y = alpha * x + beta * y
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor,
+          Scalar Alpha, Scalar ElemX, Scalar Beta, Scalar ElemY, typename Dev,
+          std::size_t Rank>
+  requires VenusTensor<Tensor<ElemX, Dev, Rank>> &&
+           VenusTensor<Tensor<ElemY, Dev, Rank>>
+void axpby(Policy &&policy, Alpha alpha, const Tensor<ElemX, Dev, Rank> &x,
+           Beta beta, Tensor<ElemY, Dev, Rank> &y) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "BLAS ops are currently only supported on CPU");
+  detail::require_same_shape(x, y);
+  detail::require_unique(y);
+
+  using AccumulatorType =
+      accumulator_t<std::common_type_t<Alpha, ElemX, Beta, ElemY>>;
+  const auto a = static_cast<AccumulatorType>(alpha);
+  const auto b = static_cast<AccumulatorType>(beta);
+  const auto *x_ptr = x.data();
+  auto *y_ptr = y.data();
+
+  auto body = [&](std::size_t i) {
+    y_ptr[i] = static_cast<ElemY>(detail::multiply_add(
+        a, static_cast<AccumulatorType>(x_ptr[i]),
+        b * static_cast<AccumulatorType>(y_ptr[i])));
+  };
+  detail::for_each_index(policy, y.size(), body);
+}
+
+template <template <typename, typename, std::size_t> class Tensor,
+          Scalar Alpha, Scalar ElemX, Scalar Beta, Scalar ElemY, typename Dev,
+          std::size_t Rank>
+  requires VenusTensor<Tensor<ElemX, Dev, Rank>> &&
+           VenusTensor<Tensor<ElemY, Dev, Rank>>
+void axpby(Alpha alpha, const Tensor<ElemX, Dev, Rank> &x, Beta beta,
+           Tensor<ElemY, Dev, Rank> &y) {
+  axpby(execution::unseq, alpha, x, beta, y);
+}
+
+// In-Place x = alpha * x
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor,
+          Scalar Alpha, Scalar Elem, typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+void scal(Policy &&policy, Alpha alpha, Tensor<Elem, Dev, Rank> &x) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "BLAS ops are currently only supported on CPU");
+  detail::require_unique(x);
+
+  using AccumulatorType = accumulator_t<std::common_type_t<Alpha, Elem>>;
+  const auto a = static_cast<AccumulatorType>(alpha);
+  auto *x_ptr = x.data();
+
+  auto body = [&](std::size_t i) {
+    x_ptr[i] = static_cast<Elem>(a * static_cast<AccumulatorType>(x_ptr[i]));
+  };
+  detail::for_each_index(policy, x.size(), body);
+}
+
+template <template <typename, typename, std::size_t> class Tensor,
+          Scalar Alpha, Scalar Elem, typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+void scal(Alpha alpha, Tensor<Elem, Dev, Rank> &x) {
+  scal(execution::unseq, alpha, x);
+}
+
+// Reductions over any set of axes in a single pass, e.g. sum<0, 2>(t) keeps
+// the reduced axes with extent 1, sum<0, 2>(t, squeeze) drops them. Without
+// axes the whole tensor is reduced to a scalar tensor. sum and mean also
+// take a summation mode, e.g. sum(t, kahan). Results do not depend on the
+// execution policy or the number of threads (see kernels::reduction_block).
+// any and all over the whole tensor stop at the first element that decides
+// them.
+REGISTER_REDUCTION(sum, SumReducer)
+REGISTER_REDUCTION(prod, ProdReducer)
+REGISTER_REDUCTION(mean, MeanReducer)
+REGISTER_REDUCTION(amax, MaxReducer)
+REGISTER_REDUCTION(amin, MinReducer)
+REGISTER_REDUCTION(any, AnyReducer)
+REGISTER_REDUCTION(all, AllReducer)
+REGISTER_REDUCTION(count_nonzero, CountNonzeroReducer)
+
+// Guards over a whole tensor without materializing a mask, e.g.
+// any_gt(x, limit), all_gte(x, 0) or count_neq(labels, -1). any and all
+// stop at the first element that decides them; NaN satisfies no comparison
+// but neq.
+REGISTER_FUSED_PREDICATE(gt, greater)
+REGISTER_FUSED_PREDICATE(gte, greater_equal)
+REGISTER_FUSED_PREDICATE(lt, less)
+REGISTER_FUSED_PREDICATE(lte, less_equal)
+REGISTER_FUSED_PREDICATE(eq, equal_to)
+REGISTER_FUSED_PREDICATE(neq, not_equal_to)
+
+// Population variance and standard deviation (divided by n), each in one
+// pass over the data with Welford's method
+REGISTER_REDUCTION(var, VarianceReducer)
+REGISTER_REDUCTION(stddev, StddevReducer)
+
+// Mean and population variance together, from a single read of the data, as
+// a (mean, variance) pair: auto [mu, sigma2] = mean_var<1>(x) gives the
+// per-row statistics of a layer norm, with shapes that broadcast against x
+template <std::size_t... Dims, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank, std::same_as<squeeze_t>... Options>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto mean_var(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,
+              Options... options) {
+  return detail::mean_var<Dims...>(policy, t, options...);
+}
+
+template <std::size_t... Dims,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank, std::same_as<squeeze_t>... Options>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto mean_var(const Tensor<Elem, Dev, Rank> &t, Options... options) {
+  return detail::mean_var<Dims...>(execution::seq, t, options...);
+}
+
+template <std::size_t Dim, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto sum_dim(Policy &&policy, const Tensor<Elem, Dev, Rank> &t)
+    -> Tensor<Elem, Dev, Rank> {
+  static_assert(Dim < Rank, "sum dimension cannot be higher than tensor rank");
+  return sum<Dim>(policy, t);
+}
+
 template <std::size_t Dim,
           template <typename, typename, std::size_t> class Tensor, Scalar Elem,
           typename Dev, std::size_t Rank>
   requires VenusTensor<Tensor<Elem, Dev, Rank>>
 auto sum_dim(const Tensor<Elem, Dev, Rank> &t) -> Tensor<Elem, Dev, Rank> {
-  static_assert(Dim < Rank, "sum dimension cannot be higher than tensor rank");
+  return sum_dim<Dim>(execution::seq, t);
+}
 
-  const auto &in_shape = t.shape();
-  std::array<std::size_t, Rank> out_ext;
-  for (std::size_t i = 0; i < Rank; i++) {
-    out_ext[i] = (i == Dim) ? 1 : in_shape[i];
+template <std::size_t... Dims, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto sum_dims(Policy &&policy, const Tensor<Elem, Dev, Rank> &t)
+    -> Tensor<Elem, Dev, Rank> {
+  if constexpr (sizeof...(Dims) == 0) {
+    return t.clone();
+  } else {
+    return sum<Dims...>(policy, t);
   }
+}
 
-  auto out_shape = Shape<Rank>(out_ext);
-  auto result = Tensor<Elem, Dev, Rank>(out_shape);
+template <std::size_t... Dims,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto sum_dims(const Tensor<Elem, Dev, Rank> &t) -> Tensor<Elem, Dev, Rank> {
+  return sum_dims<Dims...>(execution::seq, t);
+}
 
-  for (auto [flat, val] :
-       std::views::zip(std::views::iota(std::size_t{0}, t.size()), t)) {
-    auto midx = in_shape.offsetToIdx(flat);
-    midx[Dim] = 0;
-    result[midx] += val;
+// Index reductions: argmax<1>(t) gives the position of the largest element
+// along axis 1 (the first one on ties, and NaN counts as largest), keeping
+// the axis with extent 1 unless squeezed. Without an axis the result is a
+// flat index into the tensor. The *_with_indices variants return the values
+// as well, as a (values, indices) pair.
+REGISTER_ARG_REDUCTION(argmax, Greater, false)
+REGISTER_ARG_REDUCTION(argmin, Less, false)
+REGISTER_ARG_REDUCTION(max_with_indices, Greater, true)
+REGISTER_ARG_REDUCTION(min_with_indices, Less, true)
+
+// The k largest elements along Axis (the last one by default), in
+// descending order with ties by position, as a (values, indices) pair whose
+// Axis has extent k
+template <std::size_t... Axis, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto topk(Policy &&policy, const Tensor<Elem, Dev, Rank> &t, std::size_t k) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Top-k is currently only supported on CPU");
+  static_assert(Rank > 0, "Top-k needs at least one axis");
+  static_assert(sizeof...(Axis) <= 1, "Top-k takes at most one axis");
+  constexpr std::size_t axis = sizeof...(Axis) == 0 ? Rank - 1 : (Axis + ... + 0);
+  static_assert(axis < Rank, "Top-k axis cannot be higher than tensor rank");
+
+  const auto view = detail::axis_view<axis>(detail::shape_extents(t));
+  if (k == 0 or k > view.extent) {
+    throw std::invalid_argument(
+        std::format("Top-k: k = {} is out of range for an axis of extent {}",
+                    k, view.extent));
   }
 
+  auto extents = detail::shape_extents(t);
+  extents[axis] = k;
+  auto values = Tensor<Elem, Dev, Rank>(Shape<Rank>(extents));
+  auto indices = Tensor<std::size_t, Dev, Rank>(Shape<Rank>(extents));
+  kernels::top_k<kernels::Greater>(policy, t.data(), view, k, values.data(),
+                                   indices.data());
+  return std::pair{std::move(values), std::move(indices)};
+}
+
+template <std::size_t... Axis,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto topk(const Tensor<Elem, Dev, Rank> &t, std::size_t k) {
+  return topk<Axis...>(execution::seq, t, k);
+}
+
+// exp(x) / sum(exp(x)) along Axis (the last one by default), computed
+// relative to the row maximum so large inputs do not overflow; -inf entries
+// get exactly 0. log_softmax gives x - log(sum(exp(x))) without taking the
+// log of a rounded probability.
+template <std::size_t... Axis, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto softmax(Policy &&policy, const Tensor<Elem, Dev, Rank> &t)
+    -> Tensor<Elem, Dev, Rank> {
+  return detail::softmax<false, Axis...>(policy, t);
+}
+
+template <std::size_t... Axis,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto softmax(const Tensor<Elem, Dev, Rank> &t) -> Tensor<Elem, Dev, Rank> {
+  return detail::softmax<false, Axis...>(execution::seq, t);
+}
+
+template <std::size_t... Axis, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto log_softmax(Policy &&policy, const Tensor<Elem, Dev, Rank> &t)
+    -> Tensor<Elem, Dev, Rank> {
+  return detail::softmax<true, Axis...>(policy, t);
+}
+
+template <std::size_t... Axis,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto log_softmax(const Tensor<Elem, Dev, Rank> &t) -> Tensor<Elem, Dev, Rank> {
+  return detail::softmax<true, Axis...>(execution::seq, t);
+}
+
+// Cumulative scans: cumsum<1>(t)[i, j] is the sum of t[i, 0..j]. Without an
+// axis the scan runs along the last one. Results keep the input's shape and
+// element type, and are bitwise identical under every execution policy.
+REGISTER_SCAN(cumsum, SumReducer)
+REGISTER_SCAN(cumprod, ProdReducer)
+REGISTER_SCAN(cummax, MaxReducer)
+REGISTER_SCAN(cummin, MinReducer)
+
+// Distinct values of t (of any shape) in ascending order. -0 and +0 are one
+// value, and so are all NaN, which come last. unique_counts adds how often
+// each occurs, unique_inverse the position in the values of every element
+// of t (in t's shape), and unique_all both as well as the flat index of each
+// value's first occurrence: (values, indices, inverse, counts).
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto unique(Policy &&policy, const Tensor<Elem, Dev, Rank> &t)
+    -> Tensor<Elem, Dev, 1> {
+  return detail::unique(policy, t).first;
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto unique(const Tensor<Elem, Dev, Rank> &t) -> Tensor<Elem, Dev, 1> {
+  return unique(execution::seq, t);
+}
+
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto unique_counts(Policy &&policy, const Tensor<Elem, Dev, Rank> &t) {
+  auto [values, found] = detail::unique(policy, t);
+  auto counts = detail::positions<Tensor<std::size_t, Dev, 1>>(
+      found.counts.get(), found.size);
+  return std::pair{std::move(values), std::move(counts)};
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto unique_counts(const Tensor<Elem, Dev, Rank> &t) {
+  return unique_counts(execution::seq, t);
+}
+
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto unique_inverse(Policy &&policy, const Tensor<Elem, Dev, Rank> &t) {
+  auto [values, found] = detail::unique(policy, t);
+  auto inverse = Tensor<std::size_t, Dev, Rank>(t.shape());
+  std::copy(found.inverse.get(), found.inverse.get() + t.size(),
+            inverse.data());
+  return std::pair{std::move(values), std::move(inverse)};
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto unique_inverse(const Tensor<Elem, Dev, Rank> &t) {
+  return unique_inverse(execution::seq, t);
+}
+
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto unique_all(Policy &&policy, const Tensor<Elem, Dev, Rank> &t) {
+  auto [values, found] = detail::unique(policy, t);
+  auto indices = detail::positions<Tensor<std::size_t, Dev, 1>>(
+      found.first.get(), found.size);
+  auto counts = detail::positions<Tensor<std::size_t, Dev, 1>>(
+      found.counts.get(), found.size);
+  auto inverse = Tensor<std::size_t, Dev, Rank>(t.shape());
+  std::copy(found.inverse.get(), found.inverse.get() + t.size(),
+            inverse.data());
+  return std::tuple{std::move(values), std::move(indices), std::move(inverse),
+                    std::move(counts)};
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto unique_all(const Tensor<Elem, Dev, Rank> &t) {
+  return unique_all(execution::seq, t);
+}
+
+// Occurrences of each value 0, 1, ..., max(t) among the non-negative
+// integers of t (of any shape), in at least `minlength` bins
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto bincount(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,
+              std::size_t minlength = 0) -> Tensor<std::size_t, Dev, 1> {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Bincount is currently only supported on CPU");
+  static_assert(std::integral<Elem>, "Bincount needs integer values");
+
+  auto bins = minlength;
+  if (t.size() > 0) {
+    const auto [lo, hi] = detail::value_range<Elem>(policy, t);
+    if constexpr (std::is_signed_v<Elem>) {
+      if (lo < 0) {
+        throw std::invalid_argument(std::format(
+            "Bincount: values must be non-negative, found {}", lo));
+      }
+    }
+    bins = std::max(bins, static_cast<std::size_t>(hi) + 1);
+  }
+
+  auto result = Tensor<std::size_t, Dev, 1>(bins);
+  kernels::bincount(policy, t.data(), t.size(), bins, result.data());
   return result;
 }
 
-template <std::size_t... Dims,
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto bincount(const Tensor<Elem, Dev, Rank> &t, std::size_t minlength = 0)
+    -> Tensor<std::size_t, Dev, 1> {
+  return bincount(execution::seq, t, minlength);
+}
+
+// Counts of t (of any shape) over `bins` equal-width bins spanning [lo, hi],
+// the last bin closed on the right, as a (counts, edges) pair with bins + 1
+// edges. Values outside the range and NaN are not counted. Without a range
+// the bins span the values of t.
+template <execution::ExecutionPolicy Policy,
           template <typename, typename, std::size_t> class Tensor, Scalar Elem,
           typename Dev, std::size_t Rank>
   requires VenusTensor<Tensor<Elem, Dev, Rank>>
-auto sum_dims(const Tensor<Elem, Dev, Rank> &t) -> Tensor<Elem, Dev, Rank> {
-  if constexpr (sizeof...(Dims) == 0) {
-    return t.clone();
-  } else {
-    return []<std::size_t First, std::size_t... Rest>(
-               std::index_sequence<First, Rest...>, const auto &tensor) {
-      auto result = sum_dim<First>(tensor);
-      ((result = sum_dim<Rest>(result)), ...);
-      return result;
-    }(std::index_sequence<Dims...>{}, t);
+auto histogram(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,
+               std::size_t bins, double lo, double hi) {
+  using Edge = detail::histogram_edge_t<Elem>;
+  return detail::histogram(
+      policy, t, bins, {static_cast<Edge>(lo), static_cast<Edge>(hi)});
+}
+
+template <execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto histogram(Policy &&policy, const Tensor<Elem, Dev, Rank> &t,
+               std::size_t bins) {
+  using Edge = detail::histogram_edge_t<Elem>;
+  return detail::histogram(policy, t, bins,
+                           detail::value_range<Edge>(policy, t));
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto histogram(const Tensor<Elem, Dev, Rank> &t, std::size_t bins, double lo,
+               double hi) {
+  return histogram(execution::seq, t, bins, lo, hi);
+}
+
+template <template <typename, typename, std::size_t> class Tensor, Scalar Elem,
+          typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem, Dev, Rank>>
+auto histogram(const Tensor<Elem, Dev, Rank> &t, std::size_t bins) {
+  return histogram(execution::seq, t, bins);
+}
+
+// Segment reductions: segment_sum(values, ids)[s] combines the rows
+// values[r] (along the first axis) with ids[r] == s, for embedding bags and
+// graph aggregation. The result has max(ids) + 1 segments, or num_segments;
+// empty segments hold 0 for segment_sum and segment_mean, and -infinity
+// (the lowest value for integers) for segment_max. Results do not depend on
+// the execution policy or the order of the ids.
+REGISTER_SEGMENT_REDUCTION(segment_sum, SumReducer)
+REGISTER_SEGMENT_REDUCTION(segment_mean, MeanReducer)
+REGISTER_SEGMENT_REDUCTION(segment_max, MaxReducer)
+
+// dst with the slices of src along Axis added at the positions in index:
+// result[..., index[i], ...] += src[..., i, ...], repeated indices
+// accumulating. src matches dst on every other axis.
+template <std::size_t Axis = 0, execution::ExecutionPolicy Policy,
+          template <typename, typename, std::size_t> class Tensor,
+          Scalar Elem1, Scalar Elem2, typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem1, Dev, Rank>> &&
+           VenusTensor<Tensor<Elem2, Dev, Rank>>
+auto scatter_add(Policy &&policy, const Tensor<Elem1, Dev, Rank> &dst,
+                 const Tensor<std::size_t, Dev, 1> &index,
+                 const Tensor<Elem2, Dev, Rank> &src)
+    -> Tensor<Elem1, Dev, Rank> {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Scatter is currently only supported on CPU");
+  static_assert(Axis < Rank, "Scatter axis cannot be higher than tensor rank");
+
+  const auto dst_extents = detail::shape_extents(dst);
+  const auto src_extents = detail::shape_extents(src);
+  for (std::size_t d = 0; d < Rank; ++d) {
+    const auto expected = d == Axis ? index.size() : dst_extents[d];
+    if (src_extents[d] != expected) {
+      throw std::invalid_argument(std::format(
+          "Scatter: source extent {} on axis {} does not match {}",
+          src_extents[d], d, expected));
+    }
+  }
+  const auto segments = detail::segment_count(policy, index, dst_extents[Axis]);
+
+  auto result = dst.clone();
+  if (src.size() > 0) {
+    auto sums = std::make_unique<Elem2[]>(result.size());
+    kernels::segment_reduce<kernels::SumReducer<Elem2>>(
+        policy, src.data(), detail::axis_view<Axis>(src_extents), index.data(),
+        segments, sums.get());
+    auto *out = result.data();
+    execution::for_each_chunk(
+        policy, result.size(), [&](std::size_t begin, std::size_t end) {
+          for (auto k = begin; k < end; ++k) {
+            out[k] = static_cast<Elem1>(out[k] + sums[k]);
+          }
+        });
   }
+  return result;
+}
+
+template <std::size_t Axis = 0,
+          template <typename, typename, std::size_t> class Tensor,
+          Scalar Elem1, Scalar Elem2, typename Dev, std::size_t Rank>
+  requires VenusTensor<Tensor<Elem1, Dev, Rank>> &&
+           VenusTensor<Tensor<Elem2, Dev, Rank>>
+auto scatter_add(const Tensor<Elem1, Dev, Rank> &dst,
+                 const Tensor<std::size_t, Dev, 1> &index,
+                 const Tensor<Elem2, Dev, Rank> &src)
+    -> Tensor<Elem1, Dev, Rank> {
+  return scatter_add<Axis>(execution::seq, dst, index, src);
 }
 
 // Sumproduct pair
-template <std::size_t... SumDims,
+template <std::size_t... SumDims, execution::ExecutionPolicy Policy,
           template <typename, typename, std::size_t> class Tensor, Scalar Elem1,
           typename Dev1, Scalar Elem2, typename Dev2, std::size_t Rank1,
           std::size_t Rank2>
   requires VenusTensor<Tensor<Elem1, Dev1, Rank1>> &&
            VenusTensor<Tensor<Elem2, Dev2, Rank2>>
-auto sumproduct_pair(const Tensor<Elem1, Dev1, Rank1> &t1,
+auto sumproduct_pair(Policy &&policy, const Tensor<Elem1, Dev1, Rank1> &t1,
                      const Tensor<Elem2, Dev2, Rank2> &t2) {
   auto product = t1 * t2;
-  return sum_dims<SumDims...>(product);
+  return sum_dims<SumDims...>(policy, product);
 }
 
 template <ConstexprString Eqn, std::size_t NumOut,
-          typename... HomogenizedTensors>
-auto _einsum_contract(HomogenizedTensors... tensors) {
+          execution::ExecutionPolicy Policy, typename... HomogenizedTensors>
+auto _einsum_contract(Policy &&policy, HomogenizedTensors... tensors) {
   const auto &t0 = tensors...[0];
   constexpr auto initial_sum_dims = detail::compute_sum_dims_for_step<0, Eqn>();
 
   const auto initial_result =
       [&]<std::size_t... Is>(std::index_sequence<Is...>) {
         if constexpr (sizeof...(Is) > 0) {
-          return sum_dims<initial_sum_dims[Is]...>(t0);
+          return sum_dims<initial_sum_dims[Is]...>(policy, t0);
         } else {
           return t0;
         }
@@ -737,7 +2868,7 @@ auto _einsum_contract(HomogenizedTensors... tensors) {
       constexpr auto sum_dims = detail::compute_sum_dims_for_step<OpIdx, Eqn>();
       const auto &next_op = tensors...[OpIdx];
       current = [&]<std::size_t... Js>(std::index_sequence<Js...>) {
-        return sumproduct_pair<sum_dims[Js]...>(current, next_op);
+        return sumproduct_pair<sum_dims[Js]...>(policy, current, next_op);
         ;
       }(std::make_index_sequence<sum_dims.size()>{});
     };
@@ -748,11 +2879,11 @@ auto _einsum_contract(HomogenizedTensors... tensors) {
   return detail::squeeze_to_rank<NumOut>(final_contracted);
 }
 
-template <ConstexprString Eqn,
+template <ConstexprString Eqn, execution::ExecutionPolicy Policy,
           template <typename, typename, std::size_t> class... Tensors,
           typename... Ts, typename... Devs, std::size_t... Ranks>
   requires(VenusTensor<Tensors<Ts, Devs, Ranks>> && ...)
-auto einsum(const Tensors<Ts, Devs, Ranks> &...tensors) {
+auto einsum(Policy &&policy, const Tensors<Ts, Devs, Ranks> &...tensors) {
   static_assert((std::is_same_v<Devs, Device::CPU> && ...),
                 "Einsum is currently only supported on CPU");
   constexpr auto eqn = Eqn.view();
@@ -764,10 +2895,25 @@ auto einsum(const Tensors<Ts, Devs, Ranks> &...tensors) {
 
   return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
     return _einsum_contract<Eqn, num_out>(
-        detail::homogenize_operand<Is, Eqn>(tensors)...);
+        policy, detail::homogenize_operand<Is, Eqn>(tensors)...);
   }(std::make_index_sequence<sizeof...(Tensors)>{});
 }
 
+template <ConstexprString Eqn,
+          template <typename, typename, std::size_t> class... Tensors,
+          typename... Ts, typename... Devs, std::size_t... Ranks>
+  requires(VenusTensor<Tensors<Ts, Devs, Ranks>> && ...)
+auto einsum(const Tensors<Ts, Devs, Ranks> &...tensors) {
+  return einsum<Eqn>(execution::seq, tensors...);
+}
+
 } // namespace venus::eager
 
+#undef REGISTER_SEGMENT_REDUCTION
+#undef REGISTER_SCAN
+#undef REGISTER_ARG_REDUCTION
+#undef REGISTER_FUSED_WHERE
+#undef REGISTER_FUSED_TERNARY_OP
+#undef REGISTER_FUSED_PREDICATE
+#undef REGISTER_REDUCTION
 #undef REGISTER_BINARY_OP
@@ -0,0 +1,385 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <venus/kernels/qgemm.hpp>
+#include <venus/memory/device.hpp>
+#include <venus/tensor/shape.hpp>
+#include <venus/tensor/tensor.hpp>
+
+namespace venus {
+
+// Affine int8 tensor: real = scale * (value - zero_point). The scale and zero
+// point are either shared by the whole tensor or given per channel along one
+// axis (typically the output channels of a weight matrix).
+template <typename TDevice, std::size_t Rank> class QuantizedTensor {
+  static_assert(Rank > 0, "Quantized tensors need at least one dimension");
+
+public:
+  using ValueType = std::int8_t;
+  using DeviceType = TDevice;
+  static constexpr std::size_t rank = Rank;
+  static constexpr std::size_t per_tensor =
+      std::numeric_limits<std::size_t>::max();
+
+  explicit QuantizedTensor(Tensor<ValueType, DeviceType, Rank> values,
+                           float scale, std::int32_t zero_point = 0)
+      : m_values(std::move(values)), m_scales(1), m_zero_points(1),
+        m_axis(per_tensor) {
+    m_scales.data()[0] = scale;
+    m_zero_points.data()[0] = zero_point;
+    validate();
+  }
+
+  explicit QuantizedTensor(Tensor<ValueType, DeviceType, Rank> values,
+                           Tensor<float, DeviceType, 1> scales,
+                           Tensor<std::int32_t, DeviceType, 1> zero_points,
+                           std::size_t axis)
+      : m_values(std::move(values)), m_scales(std::move(scales)),
+        m_zero_points(std::move(zero_points)), m_axis(axis) {
+    if (m_axis >= Rank) {
+      throw std::invalid_argument(std::format(
+          "Quantization axis {} is out of range for a tensor of rank {}",
+          m_axis, Rank));
+    }
+    validate();
+  }
+
+  [[nodiscard]] auto shape() const noexcept -> Shape<Rank> {
+    return m_values.shape();
+  }
+  [[nodiscard]] auto size() const -> std::size_t { return m_values.size(); }
+  [[nodiscard]] auto axis() const noexcept -> std::size_t { return m_axis; }
+  [[nodiscard]] auto perChannel() const noexcept -> bool {
+    return m_axis != per_tensor;
+  }
+  [[nodiscard]] auto channels() const noexcept -> std::size_t {
+    return m_scales.size();
+  }
+
+  auto values(this auto &&self) -> decltype(auto) {
+    return (std::forward<decltype(self)>(self).m_values);
+  }
+  auto scales() const -> const Tensor<float, DeviceType, 1> & {
+    return m_scales;
+  }
+  auto zeroPoints() const -> const Tensor<std::int32_t, DeviceType, 1> & {
+    return m_zero_points;
+  }
+
+  [[nodiscard]] auto scale(std::size_t channel = 0) const -> float {
+    return m_scales.data()[channel];
+  }
+  [[nodiscard]] auto zeroPoint(std::size_t channel = 0) const
+      -> std::int32_t {
+    return m_zero_points.data()[channel];
+  }
+
+private:
+  void validate() const {
+    const auto expected = perChannel() ? m_values.shape()[m_axis] : 1;
+    if (m_scales.size() != expected or m_zero_points.size() != expected) {
+      throw std::invalid_argument(std::format(
+          "Expected {} scales and zero points, got {} and {}", expected,
+          m_scales.size(), m_zero_points.size()));
+    }
+    for (std::size_t c = 0; c < expected; ++c) {
+      const auto scale = m_scales.data()[c];
+      const auto zero_point = m_zero_points.data()[c];
+      if (not std::isfinite(scale) or scale <= 0.0F) {
+        throw std::invalid_argument(std::format(
+            "Quantization scale must be positive and finite, got {}", scale));
+      }
+      if (zero_point < std::numeric_limits<ValueType>::min() or
+          zero_point > std::numeric_limits<ValueType>::max()) {
+        throw std::invalid_argument(std::format(
+            "Quantization zero point {} does not fit in int8", zero_point));
+      }
+    }
+  }
+
+  Tensor<ValueType, DeviceType, Rank> m_values;
+  Tensor<float, DeviceType, 1> m_scales;
+  Tensor<std::int32_t, DeviceType, 1> m_zero_points;
+  std::size_t m_axis;
+};
+
+namespace eager {
+
+namespace detail {
+
+// Splits a shape around the quantization axis so per-channel loops become
+// (outer, channel, inner) nests over contiguous memory
+struct ChannelLayout {
+  std::size_t outer;
+  std::size_t channels;
+  std::size_t inner;
+};
+
+template <std::size_t Rank>
+auto channel_layout(const Shape<Rank> &shape, std::size_t axis)
+    -> ChannelLayout {
+  if (axis >= Rank) {
+    return {.outer = 1, .channels = 1, .inner = shape.count()};
+  }
+  auto layout = ChannelLayout{.outer = 1, .channels = shape[axis], .inner = 1};
+  for (std::size_t d = 0; d < axis; ++d) {
+    layout.outer *= shape[d];
+  }
+  for (std::size_t d = axis + 1; d < Rank; ++d) {
+    layout.inner *= shape[d];
+  }
+  return layout;
+}
+
+// Quantized value clamped to int8. NaN, which clamp would let through to
+// an undefined cast, maps to the zero point, i.e. real 0.
+inline auto saturate_int8(float value, float zero_point) -> std::int8_t {
+  constexpr auto lo = static_cast<float>(std::numeric_limits<std::int8_t>::min());
+  constexpr auto hi = static_cast<float>(std::numeric_limits<std::int8_t>::max());
+  if (std::isnan(value)) {
+    return static_cast<std::int8_t>(zero_point);
+  }
+  return static_cast<std::int8_t>(std::clamp(value, lo, hi));
+}
+
+template <typename Dev, std::size_t Rank, typename Elem>
+auto quantize_into(const Tensor<Elem, Dev, Rank> &tensor,
+                   QuantizedTensor<Dev, Rank> &result) {
+  const auto layout = channel_layout(tensor.shape(), result.axis());
+  const auto *src = tensor.data();
+  auto *dst = result.values().data();
+
+  for (std::size_t o = 0; o < layout.outer; ++o) {
+    for (std::size_t c = 0; c < layout.channels; ++c) {
+      const auto inv_scale = 1.0F / result.scale(c);
+      const auto zero_point = static_cast<float>(result.zeroPoint(c));
+      const auto base = ((o * layout.channels) + c) * layout.inner;
+      for (std::size_t i = 0; i < layout.inner; ++i) {
+        const auto real = static_cast<float>(
+            static_cast<accumulator_t<Elem>>(src[base + i]));
+        dst[base + i] =
+            saturate_int8(std::nearbyint(real * inv_scale) + zero_point,
+                          zero_point);
+      }
+    }
+  }
+}
+
+// Largest magnitude per channel, used to pick symmetric scales
+template <typename Dev, std::size_t Rank, typename Elem>
+auto channel_absmax(const Tensor<Elem, Dev, Rank> &tensor, std::size_t axis)
+    -> Tensor<float, Dev, 1> {
+  const auto layout = channel_layout(tensor.shape(), axis);
+  auto absmax = Tensor<float, Dev, 1>(layout.channels);
+  const auto *src = tensor.data();
+  auto *dst = absmax.data();
+
+  for (std::size_t o = 0; o < layout.outer; ++o) {
+    for (std::size_t c = 0; c < layout.channels; ++c) {
+      const auto base = ((o * layout.channels) + c) * layout.inner;
+      for (std::size_t i = 0; i < layout.inner; ++i) {
+        const auto real = static_cast<float>(
+            static_cast<accumulator_t<Elem>>(src[base + i]));
+        dst[c] = std::max(dst[c], std::abs(real));
+      }
+    }
+  }
+  return absmax;
+}
+
+// Integer matmul with zero points folded out:
+// sum_k (a - za_i) * (b - zb_j)
+//   = sum_k a * b - za_i * colsum_j - zb_j * rowsum_i + K * za_i * zb_j
+template <typename Dev>
+auto qmm_accumulate(const QuantizedTensor<Dev, 2> &a,
+                    const QuantizedTensor<Dev, 2> &b)
+    -> Tensor<std::int32_t, Dev, 2> {
+  if (a.perChannel() and a.axis() != 0) {
+    throw std::invalid_argument(
+        "Quantized matmul supports per-tensor or per-row (axis 0) "
+        "quantization of the left operand");
+  }
+  if (b.perChannel() and b.axis() != 1) {
+    throw std::invalid_argument(
+        "Quantized matmul supports per-tensor or per-column (axis 1) "
+        "quantization of the right operand");
+  }
+
+  const auto [M, K] = a.shape();
+  const auto [K2, N] = b.shape();
+
+  if (K != K2) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch between tensors in matrix mul: t1 has "
+                    "shape {}, whereas t2 has shape {}.",
+                    a.shape(), b.shape()));
+  }
+
+  const auto *a_values = a.values().data();
+  const auto *b_values = b.values().data();
+
+  // Pack B transposed so that every output is a contiguous row-row dot
+  auto b_packed = Tensor<std::int8_t, Dev, 2>(N, K);
+  auto col_sums = Tensor<std::int32_t, Dev, 1>(N);
+  for (std::size_t k = 0; k < K; ++k) {
+    for (std::size_t j = 0; j < N; ++j) {
+      b_packed.data()[(j * K) + k] = b_values[(k * N) + j];
+      col_sums.data()[j] += b_values[(k * N) + j];
+    }
+  }
+
+  auto result = Tensor<std::int32_t, Dev, 2>(M, N);
+  kernels::qgemm_s8s8s32(M, N, K, a_values, b_packed.data(), col_sums.data(),
+                         result.data());
+
+  const auto depth = static_cast<std::int32_t>(K);
+  auto *acc = result.data();
+  for (std::size_t i = 0; i < M; ++i) {
+    const auto za = a.zeroPoint(a.perChannel() ? i : 0);
+    std::int32_t row_sum = 0;
+    for (std::size_t k = 0; k < K; ++k) {
+      row_sum += a_values[(i * K) + k];
+    }
+    for (std::size_t j = 0; j < N; ++j) {
+      const auto zb = b.zeroPoint(b.perChannel() ? j : 0);
+      acc[(i * N) + j] += (depth * za * zb) - (za * col_sums.data()[j]) -
+                          (zb * row_sum);
+    }
+  }
+  return result;
+}
+
+} // namespace detail
+
+// Per-tensor quantization with a given scale and zero point
+template <typename Elem, typename Dev, std::size_t Rank>
+  requires(Rank > 0)
+auto quantize(const Tensor<Elem, Dev, Rank> &tensor, float scale,
+              std::int32_t zero_point = 0) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Quantization is currently only supported on CPU");
+
+  auto result = QuantizedTensor<Dev, Rank>(
+      Tensor<std::int8_t, Dev, Rank>(tensor.shape()), scale, zero_point);
+  detail::quantize_into(tensor, result);
+  return result;
+}
+
+// Per-channel quantization along `axis`
+template <typename Elem, typename Dev, std::size_t Rank>
+  requires(Rank > 0)
+auto quantize(const Tensor<Elem, Dev, Rank> &tensor,
+              const Tensor<float, Dev, 1> &scales,
+              const Tensor<std::int32_t, Dev, 1> &zero_points,
+              std::size_t axis) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Quantization is currently only supported on CPU");
+
+  auto result = QuantizedTensor<Dev, Rank>(
+      Tensor<std::int8_t, Dev, Rank>(tensor.shape()), scales, zero_points,
+      axis);
+  detail::quantize_into(tensor, result);
+  return result;
+}
+
+// Symmetric per-tensor quantization: zero point 0, max |x| maps to 127
+template <typename Elem, typename Dev, std::size_t Rank>
+  requires(Rank > 0)
+auto quantize_symmetric(const Tensor<Elem, Dev, Rank> &tensor) {
+  const auto absmax = detail::channel_absmax(
+      tensor, QuantizedTensor<Dev, Rank>::per_tensor);
+  const auto max_value = absmax.data()[0];
+  return quantize(tensor, max_value > 0.0F ? max_value / 127.0F : 1.0F);
+}
+
+// Symmetric per-channel quantization along Axis (e.g. weight output channels)
+template <std::size_t Axis, typename Elem, typename Dev, std::size_t Rank>
+  requires(Rank > 0)
+auto quantize_symmetric(const Tensor<Elem, Dev, Rank> &tensor) {
+  static_assert(Axis < Rank, "quantization axis cannot be higher than rank");
+
+  auto scales = detail::channel_absmax(tensor, Axis);
+  for (std::size_t c = 0; c < scales.size(); ++c) {
+    auto &scale = scales.data()[c];
+    scale = scale > 0.0F ? scale / 127.0F : 1.0F;
+  }
+  const auto zero_points = Tensor<std::int32_t, Dev, 1>(scales.size());
+  return quantize(tensor, scales, zero_points, Axis);
+}
+
+template <typename Dev, std::size_t Rank>
+auto dequantize(const QuantizedTensor<Dev, Rank> &tensor) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Dequantization is currently only supported on CPU");
+
+  const auto layout = detail::channel_layout(tensor.shape(), tensor.axis());
+  auto result = Tensor<float, Dev, Rank>(tensor.shape());
+  const auto *src = tensor.values().data();
+  auto *dst = result.data();
+
+  for (std::size_t o = 0; o < layout.outer; ++o) {
+    for (std::size_t c = 0; c < layout.channels; ++c) {
+      const auto scale = tensor.scale(c);
+      const auto zero_point = tensor.zeroPoint(c);
+      const auto base = ((o * layout.channels) + c) * layout.inner;
+      for (std::size_t i = 0; i < layout.inner; ++i) {
+        dst[base + i] =
+            scale * static_cast<float>(src[base + i] - zero_point);
+      }
+    }
+  }
+  return result;
+}
+
+// Quantized Matrix Multiplication (2D): int8 x int8 -> int32 accumulators,
+// with the zero points already subtracted. Scaling by a.scale(i) *
+// b.scale(j) gives the real-valued product.
+template <typename Dev>
+auto qmm(const QuantizedTensor<Dev, 2> &a, const QuantizedTensor<Dev, 2> &b) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Quantized MatMul is currently only supported on CPU");
+  return detail::qmm_accumulate(a, b);
+}
+
+// Quantized Matrix Multiplication (2D) with a requantization epilogue: the
+// int32 accumulators are rescaled to the output scale and zero point and
+// saturated back to int8
+template <typename Dev>
+auto qmm(const QuantizedTensor<Dev, 2> &a, const QuantizedTensor<Dev, 2> &b,
+         float out_scale, std::int32_t out_zero_point = 0) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Quantized MatMul is currently only supported on CPU");
+
+  const auto acc = detail::qmm_accumulate(a, b);
+  const auto [M, N] = acc.shape();
+
+  auto result = QuantizedTensor<Dev, 2>(Tensor<std::int8_t, Dev, 2>(M, N),
+                                        out_scale, out_zero_point);
+  const auto *src = acc.data();
+  auto *dst = result.values().data();
+  const auto zero_point = static_cast<float>(out_zero_point);
+
+  for (std::size_t i = 0; i < M; ++i) {
+    const auto row_scale = a.scale(a.perChannel() ? i : 0) / out_scale;
+    for (std::size_t j = 0; j < N; ++j) {
+      const auto multiplier = row_scale * b.scale(b.perChannel() ? j : 0);
+      dst[(i * N) + j] = detail::saturate_int8(
+          std::nearbyint(static_cast<float>(src[(i * N) + j]) * multiplier) +
+              zero_point,
+          zero_point);
+    }
+  }
+  return result;
+}
+
+} // namespace eager
+
+} // namespace venus
@@ -0,0 +1,795 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <venus/kernels/epilogue.hpp>
+#include <venus/kernels/spmm.hpp>
+#include <venus/memory/device.hpp>
+#include <venus/parallel/execution.hpp>
+#include <venus/tensor/shape.hpp>
+#include <venus/tensor/tensor.hpp>
+
+namespace venus {
+
+// Sparse matrix in coordinate format: one (row, column, value) triple per
+// stored entry, in any order, with repeated positions adding up. It is the
+// interchange format: built from a dense tensor or from nonzero() indices,
+// and converted to CSR for arithmetic.
+template <typename TElem, typename TDevice> class CooTensor {
+public:
+  using ValueType = TElem;
+  using DeviceType = TDevice;
+  static constexpr std::size_t rank = 2;
+
+  explicit CooTensor(Shape<2> shape, std::vector<std::size_t> row_indices,
+                     std::vector<std::size_t> col_indices,
+                     std::vector<ValueType> values)
+      : m_shape(std::move(shape)), m_row_indices(std::move(row_indices)),
+        m_col_indices(std::move(col_indices)), m_values(std::move(values)) {
+    validate();
+  }
+
+  [[nodiscard]] auto shape() const noexcept -> const Shape<2> & {
+    return m_shape;
+  }
+  [[nodiscard]] auto nnz() const noexcept -> std::size_t {
+    return m_values.size();
+  }
+
+  auto rowIndices() const -> const std::vector<std::size_t> & {
+    return m_row_indices;
+  }
+  auto colIndices() const -> const std::vector<std::size_t> & {
+    return m_col_indices;
+  }
+  auto values(this auto &&self) -> decltype(auto) {
+    return (std::forward<decltype(self)>(self).m_values);
+  }
+
+private:
+  void validate() const {
+    if (m_row_indices.size() != m_values.size() or
+        m_col_indices.size() != m_values.size()) {
+      throw std::invalid_argument(std::format(
+          "Expected as many row and column indices as values ({}), got {} "
+          "and {}",
+          m_values.size(), m_row_indices.size(), m_col_indices.size()));
+    }
+    for (std::size_t p = 0; p < m_values.size(); ++p) {
+      if (m_row_indices[p] >= m_shape[0] or m_col_indices[p] >= m_shape[1]) {
+        throw std::invalid_argument(std::format(
+            "Sparse entry ({}, {}) is out of range for shape {}",
+            m_row_indices[p], m_col_indices[p], m_shape));
+      }
+    }
+  }
+
+  Shape<2> m_shape;
+  std::vector<std::size_t> m_row_indices;
+  std::vector<std::size_t> m_col_indices;
+  std::vector<ValueType> m_values;
+};
+
+// Sparse matrix in compressed sparse row format: the stored entries of row i
+// are [rowOffsets()[i], rowOffsets()[i + 1]) of the column indices and
+// values, so rows are independent and every op splits across threads by
+// row
+template <typename TElem, typename TDevice> class CsrTensor {
+public:
+  using ValueType = TElem;
+  using DeviceType = TDevice;
+  static constexpr std::size_t rank = 2;
+
+  explicit CsrTensor(Shape<2> shape, std::vector<std::size_t> row_offsets,
+                     std::vector<std::size_t> col_indices,
+                     std::vector<ValueType> values)
+      : m_shape(std::move(shape)), m_row_offsets(std::move(row_offsets)),
+        m_col_indices(std::move(col_indices)), m_values(std::move(values)) {
+    validate();
+  }
+
+  [[nodiscard]] auto shape() const noexcept -> const Shape<2> & {
+    return m_shape;
+  }
+  [[nodiscard]] auto nnz() const noexcept -> std::size_t {
+    return m_values.size();
+  }
+
+  auto rowOffsets() const -> const std::vector<std::size_t> & {
+    return m_row_offsets;
+  }
+  auto colIndices() const -> const std::vector<std::size_t> & {
+    return m_col_indices;
+  }
+  auto values(this auto &&self) -> decltype(auto) {
+    return (std::forward<decltype(self)>(self).m_values);
+  }
+
+private:
+  void validate() const {
+    if (m_row_offsets.size() != m_shape[0] + 1 or m_row_offsets.front() != 0 or
+        not std::ranges::is_sorted(m_row_offsets) or
+        m_row_offsets.back() != m_values.size() or
+        m_col_indices.size() != m_values.size()) {
+      throw std::invalid_argument(std::format(
+          "Expected {} nondecreasing row offsets from 0 to the {} values, "
+          "and as many column indices",
+          m_shape[0] + 1, m_values.size()));
+    }
+    for (const auto col : m_col_indices) {
+      if (col >= m_shape[1]) {
+        throw std::invalid_argument(std::format(
+            "Sparse column {} is out of range for shape {}", col, m_shape));
+      }
+    }
+  }
+
+  Shape<2> m_shape;
+  std::vector<std::size_t> m_row_offsets;
+  std::vector<std::size_t> m_col_indices;
+  std::vector<ValueType> m_values;
+};
+
+// Sparse matrix with 2:4 structured sparsity, e.g. a pruned weight: every
+// group of four consecutive entries of a row keeps two, stored as K / 2
+// values per row in column order plus kernels::structured_metadata_stride(K)
+// bytes of positions (kernels/spmm.hpp has the layout). Rows are as regular
+// as dense ones, with half the values to read and multiply.
+template <typename TElem, typename TDevice> class SemiStructuredTensor {
+public:
+  using ValueType = TElem;
+  using DeviceType = TDevice;
+  static constexpr std::size_t rank = 2;
+
+  explicit SemiStructuredTensor(Shape<2> shape, std::vector<ValueType> values,
+                                std::vector<std::uint8_t> metadata)
+      : m_shape(std::move(shape)), m_values(std::move(values)),
+        m_metadata(std::move(metadata)) {
+    validate();
+  }
+
+  [[nodiscard]] auto shape() const noexcept -> const Shape<2> & {
+    return m_shape;
+  }
+  [[nodiscard]] auto nnz() const noexcept -> std::size_t {
+    return m_values.size();
+  }
+
+  auto values(this auto &&self) -> decltype(auto) {
+    return (std::forward<decltype(self)>(self).m_values);
+  }
+  auto metadata() const -> const std::vector<std::uint8_t> & {
+    return m_metadata;
+  }
+
+private:
+  void validate() const {
+    const auto [M, K] = m_shape;
+    if (K % kernels::structured_group != 0) {
+      throw std::invalid_argument(std::format(
+          "2:4 structured sparsity needs a multiple of 4 columns, got shape {}",
+          m_shape));
+    }
+    const auto stride = kernels::structured_metadata_stride(K);
+    if (m_values.size() != M * (K / 2) or m_metadata.size() != M * stride) {
+      throw std::invalid_argument(std::format(
+          "Expected {} values and {} metadata bytes for shape {}, got {} and "
+          "{}",
+          M * (K / 2), M * stride, m_shape, m_values.size(),
+          m_metadata.size()));
+    }
+    const auto groups = K / kernels::structured_group;
+    for (std::size_t i = 0; i < M; ++i) {
+      for (std::size_t g = 0; g < groups; ++g) {
+        const auto [k0, k1] =
+            kernels::detail::structured_columns(&m_metadata[i * stride], g);
+        if (k0 >= k1) {
+          throw std::invalid_argument(std::format(
+              "Row {} group {} keeps positions {} and {}, expected two "
+              "increasing positions",
+              i, g, k0 % kernels::structured_group,
+              k1 % kernels::structured_group));
+        }
+      }
+    }
+  }
+
+  Shape<2> m_shape;
+  std::vector<ValueType> m_values;
+  std::vector<std::uint8_t> m_metadata;
+};
+
+namespace eager {
+
+namespace detail {
+
+inline void check_sparse_shapes(std::string_view op, const Shape<2> &sparse,
+                                const Shape<2> &dense) {
+  if (sparse != dense) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch between tensors in sparse {}: the sparse "
+                    "tensor has shape {}, whereas the dense one has shape {}.",
+                    op, sparse, dense));
+  }
+}
+
+// Dense result of (+/-) dense (+/-) sparse, each row written from the dense
+// operand and then updated at its stored entries
+template <typename Result, bool NegateDense, bool NegateSparse,
+          typename Policy, typename Elem1, typename Elem2, typename Dev>
+auto sparse_dense_add(Policy &&policy, const CsrTensor<Elem1, Dev> &sparse,
+                      const Tensor<Elem2, Dev, 2> &dense)
+    -> Tensor<Result, Dev, 2> {
+  using Acc = accumulator_t<Result>;
+  const auto M = dense.shape()[0];
+  const auto N = dense.shape()[1];
+  auto result = Tensor<Result, Dev, 2>(dense.shape());
+  const auto *offsets = sparse.rowOffsets().data();
+  const auto *cols = sparse.colIndices().data();
+  const auto *values = sparse.values().data();
+  const auto *src = dense.data();
+  auto *dst = result.data();
+
+  execution::for_each_chunk(
+      policy, M,
+      [&](std::size_t row_begin, std::size_t row_end) {
+        for (auto i = row_begin; i < row_end; ++i) {
+          for (std::size_t j = 0; j < N; ++j) {
+            const auto value = static_cast<Acc>(src[(i * N) + j]);
+            dst[(i * N) + j] = static_cast<Result>(
+                NegateDense ? static_cast<Acc>(-value) : value);
+          }
+          for (auto p = offsets[i]; p < offsets[i + 1]; ++p) {
+            auto &out = dst[(i * N) + cols[p]];
+            const auto value = static_cast<Acc>(values[p]);
+            out = static_cast<Result>(
+                NegateSparse ? static_cast<Acc>(out) - value
+                             : static_cast<Acc>(out) + value);
+          }
+        }
+      },
+      std::max<std::size_t>(execution::default_grain / N, 1));
+  return result;
+}
+
+} // namespace detail
+
+// The nonzero entries of a dense matrix, in row-major order
+template <typename Elem, typename Dev>
+auto to_coo(const Tensor<Elem, Dev, 2> &dense) -> CooTensor<Elem, Dev> {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Sparse tensors are currently only supported on CPU");
+
+  const auto [M, N] = dense.shape();
+  std::vector<std::size_t> rows;
+  std::vector<std::size_t> cols;
+  std::vector<Elem> values;
+  for (std::size_t i = 0; i < M; ++i) {
+    for (std::size_t j = 0; j < N; ++j) {
+      if (const auto value = dense.data()[(i * N) + j]; value != Elem{}) {
+        rows.push_back(i);
+        cols.push_back(j);
+        values.push_back(value);
+      }
+    }
+  }
+  return CooTensor<Elem, Dev>(dense.shape(), std::move(rows), std::move(cols),
+                              std::move(values));
+}
+
+// The entries of a dense matrix at [nnz, 2] indices as nonzero() returns
+// them, e.g. nonzero() of a mask over the matrix
+template <typename Elem, typename Dev>
+auto to_coo(const Tensor<Elem, Dev, 2> &dense,
+            const Tensor<std::size_t, Dev, 2> &indices)
+    -> CooTensor<Elem, Dev> {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Sparse tensors are currently only supported on CPU");
+
+  const auto [nnz, rank] = indices.shape();
+  if (rank != 2) {
+    throw std::invalid_argument(std::format(
+        "Expected [nnz, 2] indices into a matrix, got shape {}",
+        indices.shape()));
+  }
+  std::vector<std::size_t> rows(nnz);
+  std::vector<std::size_t> cols(nnz);
+  for (std::size_t p = 0; p < nnz; ++p) {
+    rows[p] = indices.data()[2 * p];
+    cols[p] = indices.data()[(2 * p) + 1];
+  }
+  // Validated before the values are read
+  auto result =
+      CooTensor<Elem, Dev>(dense.shape(), std::move(rows), std::move(cols),
+                           std::vector<Elem>(nnz));
+  const auto N = dense.shape()[1];
+  for (std::size_t p = 0; p < nnz; ++p) {
+    result.values()[p] =
+        dense.data()[(result.rowIndices()[p] * N) + result.colIndices()[p]];
+  }
+  return result;
+}
+
+template <typename Elem, typename Dev>
+auto to_coo(const CsrTensor<Elem, Dev> &sparse) -> CooTensor<Elem, Dev> {
+  std::vector<std::size_t> rows(sparse.nnz());
+  const auto &offsets = sparse.rowOffsets();
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    std::fill(rows.begin() + static_cast<std::ptrdiff_t>(offsets[i]),
+              rows.begin() + static_cast<std::ptrdiff_t>(offsets[i + 1]), i);
+  }
+  return CooTensor<Elem, Dev>(sparse.shape(), std::move(rows),
+                              sparse.colIndices(), sparse.values());
+}
+
+// The nonzero entries of a dense matrix, row by row
+template <typename Elem, typename Dev>
+auto to_csr(const Tensor<Elem, Dev, 2> &dense) -> CsrTensor<Elem, Dev> {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Sparse tensors are currently only supported on CPU");
+
+  const auto [M, N] = dense.shape();
+  std::vector<std::size_t> offsets(M + 1);
+  std::vector<std::size_t> cols;
+  std::vector<Elem> values;
+  for (std::size_t i = 0; i < M; ++i) {
+    for (std::size_t j = 0; j < N; ++j) {
+      if (const auto value = dense.data()[(i * N) + j]; value != Elem{}) {
+        cols.push_back(j);
+        values.push_back(value);
+      }
+    }
+    offsets[i + 1] = values.size();
+  }
+  return CsrTensor<Elem, Dev>(dense.shape(), std::move(offsets),
+                              std::move(cols), std::move(values));
+}
+
+// CSR with the columns of every row sorted and repeated positions summed
+template <typename Elem, typename Dev>
+auto to_csr(const CooTensor<Elem, Dev> &sparse) -> CsrTensor<Elem, Dev> {
+  const auto &rows = sparse.rowIndices();
+  const auto &cols = sparse.colIndices();
+  std::vector<std::size_t> order(sparse.nnz());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::ranges::stable_sort(order, [&](std::size_t p, std::size_t q) {
+    return std::pair(rows[p], cols[p]) < std::pair(rows[q], cols[q]);
+  });
+
+  std::vector<std::size_t> offsets(sparse.shape()[0] + 1);
+  std::vector<std::size_t> out_cols;
+  std::vector<Elem> out_values;
+  for (std::size_t q = 0; q < order.size(); ++q) {
+    const auto p = order[q];
+    const auto value = sparse.values()[p];
+    if (q > 0 and rows[order[q - 1]] == rows[p] and
+        cols[order[q - 1]] == cols[p]) {
+      out_values.back() =
+          static_cast<Elem>(static_cast<accumulator_t<Elem>>(out_values.back()) +
+                            static_cast<accumulator_t<Elem>>(value));
+    } else {
+      out_cols.push_back(cols[p]);
+      out_values.push_back(value);
+      ++offsets[rows[p] + 1];
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  return CsrTensor<Elem, Dev>(sparse.shape(), std::move(offsets),
+                              std::move(out_cols), std::move(out_values));
+}
+
+template <typename Elem, typename Dev>
+auto to_dense(const CooTensor<Elem, Dev> &sparse) -> Tensor<Elem, Dev, 2> {
+  auto result = Tensor<Elem, Dev, 2>(sparse.shape());
+  const auto N = sparse.shape()[1];
+  for (std::size_t p = 0; p < sparse.nnz(); ++p) {
+    auto &out =
+        result.data()[(sparse.rowIndices()[p] * N) + sparse.colIndices()[p]];
+    out = static_cast<Elem>(static_cast<accumulator_t<Elem>>(out) +
+                            static_cast<accumulator_t<Elem>>(
+                                sparse.values()[p]));
+  }
+  return result;
+}
+
+template <typename Elem, typename Dev>
+auto to_dense(const CsrTensor<Elem, Dev> &sparse) -> Tensor<Elem, Dev, 2> {
+  auto result = Tensor<Elem, Dev, 2>(sparse.shape());
+  const auto N = sparse.shape()[1];
+  const auto &offsets = sparse.rowOffsets();
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    for (auto p = offsets[i]; p < offsets[i + 1]; ++p) {
+      auto &out = result.data()[(i * N) + sparse.colIndices()[p]];
+      out = static_cast<Elem>(static_cast<accumulator_t<Elem>>(out) +
+                              static_cast<accumulator_t<Elem>>(
+                                  sparse.values()[p]));
+    }
+  }
+  return result;
+}
+
+// Prunes a dense [M, K] matrix to 2:4 structured sparsity: the two entries
+// of largest magnitude in every group of four are kept (the first ones on
+// ties), the other two are dropped. NaN ranks above every number, so a NaN
+// weight is kept and shows in the product rather than vanishing.
+template <typename Elem, typename Dev>
+auto to_semi_structured(const Tensor<Elem, Dev, 2> &dense)
+    -> SemiStructuredTensor<Elem, Dev> {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Sparse tensors are currently only supported on CPU");
+
+  const auto [M, K] = dense.shape();
+  if (K % kernels::structured_group != 0) {
+    throw std::invalid_argument(std::format(
+        "2:4 structured sparsity needs a multiple of 4 columns, got shape {}",
+        dense.shape()));
+  }
+  // (is NaN, |value|), with integer magnitudes unsigned so that the most
+  // negative value has one too
+  const auto rank = [](Elem value) {
+    if constexpr (std::is_floating_point_v<Elem>) {
+      return std::pair(std::isnan(value), std::abs(value));
+    } else if constexpr (std::is_integral_v<Elem> and std::is_signed_v<Elem>) {
+      using Magnitude = std::make_unsigned_t<Elem>;
+      const auto bits = static_cast<Magnitude>(value);
+      return std::pair(false, static_cast<Magnitude>(
+                                  value < Elem{} ? Magnitude{} - bits : bits));
+    } else {
+      return std::pair(false, value);
+    }
+  };
+
+  const auto groups = K / kernels::structured_group;
+  const auto stride = kernels::structured_metadata_stride(K);
+  std::vector<Elem> values(M * (K / 2));
+  std::vector<std::uint8_t> metadata(M * stride);
+  for (std::size_t i = 0; i < M; ++i) {
+    for (std::size_t g = 0; g < groups; ++g) {
+      const auto *group =
+          dense.data() + (i * K) + (g * kernels::structured_group);
+      // The smallest two positions by magnitude are dropped
+      std::array<std::size_t, 4> order{0, 1, 2, 3};
+      std::ranges::stable_sort(order, [&](std::size_t p, std::size_t q) {
+        return rank(group[p]) > rank(group[q]);
+      });
+      const auto p0 = std::min(order[0], order[1]);
+      const auto p1 = std::max(order[0], order[1]);
+      values[(i * (K / 2)) + (2 * g)] = group[p0];
+      values[(i * (K / 2)) + (2 * g) + 1] = group[p1];
+      metadata[(i * stride) + (g / 2)] |=
+          static_cast<std::uint8_t>((p0 | (p1 << 2)) << (4 * (g % 2)));
+    }
+  }
+  return SemiStructuredTensor<Elem, Dev>(dense.shape(), std::move(values),
+                                         std::move(metadata));
+}
+
+template <typename Elem, typename Dev>
+auto to_dense(const SemiStructuredTensor<Elem, Dev> &sparse)
+    -> Tensor<Elem, Dev, 2> {
+  auto result = Tensor<Elem, Dev, 2>(sparse.shape());
+  const auto [M, K] = sparse.shape();
+  const auto groups = K / kernels::structured_group;
+  const auto stride = kernels::structured_metadata_stride(K);
+  for (std::size_t i = 0; i < M; ++i) {
+    for (std::size_t g = 0; g < groups; ++g) {
+      const auto [k0, k1] = kernels::detail::structured_columns(
+          sparse.metadata().data() + (i * stride), g);
+      result.data()[(i * K) + k0] = sparse.values()[(i * (K / 2)) + (2 * g)];
+      result.data()[(i * K) + k1] =
+          sparse.values()[(i * (K / 2)) + (2 * g) + 1];
+    }
+  }
+  return result;
+}
+
+// Sparse x dense Matrix Multiplication (SpMM): only the stored entries of
+// the sparse matrix are multiplied, each scaling a row of the dense one
+template <execution::ExecutionPolicy Policy, typename Elem1, typename Elem2,
+          typename Dev>
+auto mm(Policy &&policy, const CsrTensor<Elem1, Dev> &t1,
+        const Tensor<Elem2, Dev, 2> &t2) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Sparse MatMul is currently only supported on CPU");
+
+  using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  using AccumulatorType = accumulator_t<ResultElementType>;
+  const auto [I, K] = t1.shape();
+  const auto [K2, J] = t2.shape();
+  if (K != K2) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch between tensors in sparse matrix mul: t1 "
+                    "has shape {}, whereas t2 has shape {}.",
+                    t1.shape(), t2.shape()));
+  }
+
+  auto t3 = Tensor<AccumulatorType, Dev, 2>(I, J);
+  kernels::spmm<AccumulatorType>(policy, I, J, t1.rowOffsets().data(),
+                                 t1.colIndices().data(), t1.values().data(),
+                                 t2.data(), J, t3.data(), J);
+
+  if constexpr (std::is_same_v<AccumulatorType, ResultElementType>) {
+    return t3;
+  } else {
+    return cast<ResultElementType>(t3);
+  }
+}
+
+template <typename Elem1, typename Elem2, typename Dev>
+auto mm(const CsrTensor<Elem1, Dev> &t1, const Tensor<Elem2, Dev, 2> &t2) {
+  return mm(execution::seq, t1, t2);
+}
+
+// Sparse Matrix-Vector Multiplication (SpMV)
+template <execution::ExecutionPolicy Policy, typename Elem1, typename Elem2,
+          typename Dev>
+auto mv(Policy &&policy, const CsrTensor<Elem1, Dev> &t1,
+        const Tensor<Elem2, Dev, 1> &t2) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Sparse MatMul is currently only supported on CPU");
+
+  using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  const auto [I, K] = t1.shape();
+  if (K != t2.shape()[0]) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch between tensors in sparse matrix-vector "
+                    "mul: t1 has shape {}, whereas t2 has shape {}.",
+                    t1.shape(), t2.shape()));
+  }
+
+  auto result = Tensor<ResultElementType, Dev, 1>(I);
+  kernels::spmv<accumulator_t<ResultElementType>>(
+      policy, I, t1.rowOffsets().data(), t1.colIndices().data(),
+      t1.values().data(), t2.data(), result.data());
+  return result;
+}
+
+template <typename Elem1, typename Elem2, typename Dev>
+auto mv(const CsrTensor<Elem1, Dev> &t1, const Tensor<Elem2, Dev, 1> &t2) {
+  return mv(execution::seq, t1, t2);
+}
+
+// 2:4 structured x dense Matrix Multiplication: half the multiply-adds of
+// the dense product, with the values of A read in order as in a dense GEMM
+template <execution::ExecutionPolicy Policy, typename Elem1, typename Elem2,
+          typename Dev>
+auto mm(Policy &&policy, const SemiStructuredTensor<Elem1, Dev> &t1,
+        const Tensor<Elem2, Dev, 2> &t2) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Sparse MatMul is currently only supported on CPU");
+
+  using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  using AccumulatorType = accumulator_t<ResultElementType>;
+  const auto [I, K] = t1.shape();
+  const auto [K2, J] = t2.shape();
+  if (K != K2) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch between tensors in sparse matrix mul: t1 "
+                    "has shape {}, whereas t2 has shape {}.",
+                    t1.shape(), t2.shape()));
+  }
+
+  auto t3 = Tensor<AccumulatorType, Dev, 2>(I, J);
+  kernels::spmm_2_4<AccumulatorType>(policy, I, J, K, t1.values().data(),
+                                     t1.metadata().data(), t2.data(), J,
+                                     t3.data(), J);
+
+  if constexpr (std::is_same_v<AccumulatorType, ResultElementType>) {
+    return t3;
+  } else {
+    return cast<ResultElementType>(t3);
+  }
+}
+
+template <typename Elem1, typename Elem2, typename Dev>
+auto mm(const SemiStructuredTensor<Elem1, Dev> &t1,
+        const Tensor<Elem2, Dev, 2> &t2) {
+  return mm(execution::seq, t1, t2);
+}
+
+// Linear layer with a 2:4 pruned weight, activation(x W^T + bias), for x of
+// shape [..., in] and a weight [out, in]. Computed as W x^T so that the
+// sparse weight is the streamed operand: a single input row is a 2:4
+// matrix-vector product, more rows share packed panels of x^T.
+template <execution::ExecutionPolicy Policy, typename Elem1, typename Elem2,
+          typename Elem3, typename Dev, std::size_t Rank>
+auto linear(Policy &&policy, const Tensor<Elem1, Dev, Rank> &x,
+            const SemiStructuredTensor<Elem2, Dev> &weight,
+            const Tensor<Elem3, Dev, 1> &bias,
+            Activation activation = Activation::none) {
+  static_assert(std::is_same_v<Dev, Device::CPU>,
+                "Linear is currently only supported on CPU");
+
+  using ResultElementType = std::common_type_t<Elem1, Elem2, Elem3>;
+  using AccumulatorType = accumulator_t<ResultElementType>;
+  const auto [N, K] = weight.shape();
+  if (x.shape()[Rank - 1] != K) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch in linear: the input has shape {}, "
+                    "whereas the weight has shape {}.",
+                    x.shape(), weight.shape()));
+  }
+  if (bias.shape()[0] != N) {
+    throw std::invalid_argument(
+        std::format("Shape mismatch in linear: the weight has shape {}, "
+                    "whereas the bias has shape {}.",
+                    weight.shape(), bias.shape()));
+  }
+
+  std::array<std::size_t, Rank> out_dims{};
+  for (std::size_t d = 0; d < Rank; ++d) {
+    out_dims[d] = x.shape()[d];
+  }
+  out_dims[Rank - 1] = N;
+  const auto R = x.size() / K;
+
+  // x^T [K, R], unless x is a single row and already is one
+  std::vector<Elem1> x_t;
+  if (R > 1) {
+    x_t.resize(K * R);
+    execution::for_each_chunk(
+        policy, K,
+        [&](std::size_t k_begin, std::size_t k_end) {
+          for (auto k = k_begin; k < k_end; ++k) {
+            for (std::size_t r = 0; r < R; ++r) {
+              x_t[(k * R) + r] = x.data()[(r * K) + k];
+            }
+          }
+        },
+        std::max<std::size_t>(execution::default_grain / R, 1));
+  }
+  std::vector<AccumulatorType> y_t(N * R);
+  kernels::spmm_2_4<AccumulatorType>(
+      policy, N, R, K, weight.values().data(), weight.metadata().data(),
+      R > 1 ? x_t.data() : x.data(), R, y_t.data(), R);
+
+  auto result = Tensor<AccumulatorType, Dev, Rank>(Shape<Rank>(out_dims));
+  execution::for_each_chunk(
+      policy, R,
+      [&](std::size_t row_begin, std::size_t row_end) {
+        for (auto r = row_begin; r < row_end; ++r) {
+          for (std::size_t n = 0; n < N; ++n) {
+            result.data()[(r * N) + n] = kernels::activate<AccumulatorType>(
+                activation, y_t[(n * R) + r] +
+                                static_cast<AccumulatorType>(bias.data()[n]));
+          }
+        }
+      },
+      std::max<std::size_t>(execution::default_grain / N, 1));
+
+  if constexpr (std::is_same_v<AccumulatorType, ResultElementType>) {
+    return result;
+  } else {
+    return cast<ResultElementType>(result);
+  }
+}
+
+template <typename Elem1, typename Elem2, typename Elem3, typename Dev,
+          std::size_t Rank>
+auto linear(const Tensor<Elem1, Dev, Rank> &x,
+            const SemiStructuredTensor<Elem2, Dev> &weight,
+            const Tensor<Elem3, Dev, 1> &bias,
+            Activation activation = Activation::none) {
+  return linear(execution::seq, x, weight, bias, activation);
+}
+
+// Sparse + dense, a dense matrix
+template <execution::ExecutionPolicy Policy, typename Elem1, typename Elem2,
+          typename Dev>
+auto add(Policy &&policy, const CsrTensor<Elem1, Dev> &t1,
+         const Tensor<Elem2, Dev, 2> &t2) {
+  detail::check_sparse_shapes("add", t1.shape(), t2.shape());
+  return detail::sparse_dense_add<std::common_type_t<Elem1, Elem2>, false,
+                                  false>(policy, t1, t2);
+}
+
+template <execution::ExecutionPolicy Policy, typename Elem1, typename Elem2,
+          typename Dev>
+auto add(Policy &&policy, const Tensor<Elem1, Dev, 2> &t1,
+         const CsrTensor<Elem2, Dev> &t2) {
+  return add(policy, t2, t1);
+}
+
+template <typename Elem1, typename Elem2, typename Dev>
+auto add(const CsrTensor<Elem1, Dev> &t1, const Tensor<Elem2, Dev, 2> &t2) {
+  return add(execution::seq, t1, t2);
+}
+
+template <typename Elem1, typename Elem2, typename Dev>
+auto add(const Tensor<Elem1, Dev, 2> &t1, const CsrTensor<Elem2, Dev> &t2) {
+  return add(execution::seq, t2, t1);
+}
+
+// Sparse - dense and dense - sparse, dense matrices
+template <execution::ExecutionPolicy Policy, typename Elem1, typename Elem2,
+          typename Dev>
+auto sub(Policy &&policy, const CsrTensor<Elem1, Dev> &t1,
+         const Tensor<Elem2, Dev, 2> &t2) {
+  detail::check_sparse_shapes("sub", t1.shape(), t2.shape());
+  return detail::sparse_dense_add<std::common_type_t<Elem1, Elem2>, true,
+                                  false>(policy, t1, t2);
+}
+
+template <execution::ExecutionPolicy Policy, typename Elem1, typename Elem2,
+          typename Dev>
+auto sub(Policy &&policy, const Tensor<Elem1, Dev, 2> &t1,
+         const CsrTensor<Elem2, Dev> &t2) {
+  detail::check_sparse_shapes("sub", t2.shape(), t1.shape());
+  return detail::sparse_dense_add<std::common_type_t<Elem1, Elem2>, false,
+                                  true>(policy, t2, t1);
+}
+
+template <typename Elem1, typename Elem2, typename Dev>
+auto sub(const CsrTensor<Elem1, Dev> &t1, const Tensor<Elem2, Dev, 2> &t2) {
+  return sub(execution::seq, t1, t2);
+}
+
+template <typename Elem1, typename Elem2, typename Dev>
+auto sub(const Tensor<Elem1, Dev, 2> &t1, const CsrTensor<Elem2, Dev> &t2) {
+  return sub(execution::seq, t1, t2);
+}
+
+// Sparse * dense, elementwise: a sparse matrix with the same stored
+// positions, products that happen to be zero included
+template <execution::ExecutionPolicy Policy, typename Elem1, typename Elem2,
+          typename Dev>
+auto mul(Policy &&policy, const CsrTensor<Elem1, Dev> &t1,
+         const Tensor<Elem2, Dev, 2> &t2) {
+  detail::check_sparse_shapes("mul", t1.shape(), t2.shape());
+
+  using ResultElementType = std::common_type_t<Elem1, Elem2>;
+  using AccumulatorType = accumulator_t<ResultElementType>;
+  const auto M = t1.shape()[0];
+  const auto N = t1.shape()[1];
+  const auto *offsets = t1.rowOffsets().data();
+  const auto *cols = t1.colIndices().data();
+  const auto *values = t1.values().data();
+  std::vector<ResultElementType> products(t1.nnz());
+
+  execution::for_each_chunk(
+      policy, M,
+      [&](std::size_t row_begin, std::size_t row_end) {
+        for (auto i = row_begin; i < row_end; ++i) {
+          for (auto p = offsets[i]; p < offsets[i + 1]; ++p) {
+            products[p] = static_cast<ResultElementType>(
+                static_cast<AccumulatorType>(values[p]) *
+                static_cast<AccumulatorType>(t2.data()[(i * N) + cols[p]]));
+          }
+        }
+      },
+      kernels::detail::sparse_row_grain(M, t1.nnz(), 1));
+  return CsrTensor<ResultElementType, Dev>(t1.shape(), t1.rowOffsets(),
+                                           t1.colIndices(),
+                                           std::move(products));
+}
+
+template <execution::ExecutionPolicy Policy, typename Elem1, typename Elem2,
+          typename Dev>
+auto mul(Policy &&policy, const Tensor<Elem1, Dev, 2> &t1,
+         const CsrTensor<Elem2, Dev> &t2) {
+  return mul(policy, t2, t1);
+}
+
+template <typename Elem1, typename Elem2, typename Dev>
+auto mul(const CsrTensor<Elem1, Dev> &t1, const Tensor<Elem2, Dev, 2> &t2) {
+  return mul(execution::seq, t1, t2);
+}
+
+template <typename Elem1, typename Elem2, typename Dev>
+auto mul(const Tensor<Elem1, Dev, 2> &t1, const CsrTensor<Elem2, Dev> &t2) {
+  return mul(execution::seq, t2, t1);
+}
+
+} // namespace eager
+
+} // namespace venus
@@ -219,17 +219,19 @@ public:
     return venus::eager::neq(*this, std::forward<OtherType>(other));
   }
 
-  // Inner product
-  template <typename OtherElementType>
-  auto inner(const Tensor<OtherElementType, DeviceType, Rank> &other) const {
-    return venus::eager::inner(*this, other);
+  // Inner product, optionally with a summation mode (eager::kahan, ...)
+  template <typename OtherElementType, typename... Modes>
+  auto inner(const Tensor<OtherElementType, DeviceType, Rank> &other,
+             Modes... modes) const {
+    return venus::eager::inner(*this, other, modes...);
   }
 
   // Dot product
-  template <typename OtherElementType>
+  template <typename OtherElementType, typename... Modes>
     requires(Rank == 1)
-  auto dot(const Tensor<OtherElementType, DeviceType, Rank> &other) const {
-    return venus::eager::dot(*this, other);
+  auto dot(const Tensor<OtherElementType, DeviceType, Rank> &other,
+           Modes... modes) const {
+    return venus::eager::dot(*this, other, modes...);
   }
 
   // In-Place Transform
@@ -242,6 +244,20 @@ public:
     std::ranges::transform(self, self.begin(), std::forward<Fn>(fn));
   }
 
+  // In-Place Transform with an execution policy
+  template <execution::ExecutionPolicy Policy, typename Fn>
+  void transform(this auto &&self, Policy &&policy, Fn &&fn)
+    requires(!std::is_const_v<std::remove_reference_t<decltype(self)>>)
+  {
+    static_assert(std::is_same_v<DeviceType, Device::CPU>,
+                  "Transform is currently only supported on CPU");
+    if (not self.unique()) {
+      throw std::runtime_error("Cannot write to shared tensor");
+    }
+    venus::eager::detail::transform_range(policy, self.data(), self.data(),
+                                          self.size(), fn);
+  }
+
   // In-Place Sort
   void sort(this auto &&self)
     requires(!std::is_const_v<std::remove_reference_t<decltype(self)>>)
@@ -670,7 +686,7 @@ auto operator<<(std::ostream &os, const Tensor<TElem, TDevice, Rank> &tensor)
       os << "\"" << static_cast<TElem>(elem) << "\"";
     } else if constexpr (CharLike<TElem>) {
       os << "'" << static_cast<TElem>(elem) << "'";
-    } else if constexpr (std::floating_point<TElem>) {
+    } else if constexpr (std::floating_point<TElem> || HalfFloat<TElem>) {
       os << std::fixed << std::setprecision(2) << static_cast<TElem>(elem);
     } else {
       os << static_cast<TElem>(elem);
@@ -687,7 +703,7 @@ auto operator<<(std::ostream &os, const Tensor<TElem, TDevice, 0> &tensor)
     return os << "venus::Tensor(" << "\"" << tensor.value() << "\"" << ")";
   } else if constexpr (CharLike<TElem>) {
     return os << "venus::Tensor(" << "'" << tensor.value() << "'" << ")";
-  } else if constexpr (std::floating_point<TElem>) {
+  } else if constexpr (std::floating_point<TElem> || HalfFloat<TElem>) {
     return os << std::fixed << std::setprecision(2) << "venus::Tensor("
               << tensor.value() << ")";
   } else {
@@ -0,0 +1,28 @@
+#include <print>
+#include <venus/kernels/cache_info.hpp>
+#include <venus/kernels/gemm.hpp>
+#include <venus/kernels/gemm_tuning.hpp>
+
+using namespace venus;
+
+// Tunes the GEMM blocking for this host and stores it in the tuning cache,
+// where mm, matmul and linear pick it up from then on
+template <typename T> void tune(const char *name) {
+  const auto before = kernels::default_gemm_blocking<T>();
+  const auto after = kernels::autotune_gemm<T>();
+  std::println("{:>7}: default mc {:>5} kc {:>4} nc {:>6}, tuned mc {:>5} "
+               "kc {:>4} nc {:>6}",
+               name, before.mc, before.kc, before.nc, after.mc, after.kc,
+               after.nc);
+}
+
+auto main() -> int {
+  const auto &caches = kernels::cache_sizes();
+  std::println("L1d {} KiB, L2 {} KiB, L3 share {} KiB", caches.l1d >> 10,
+               caches.l2 >> 10, caches.l3 >> 10);
+
+  tune<float>("float");
+  tune<double>("double");
+
+  std::println("Stored in {}", kernels::gemm_tuning_cache_path().string());
+}
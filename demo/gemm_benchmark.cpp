@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <print>
+#include <venus/tensor/eager.hpp>
+#include <venus/tensor/tensor.hpp>
+
+using namespace venus;
+
+// The i-k-j loop eager::mm used before it was blocked, for comparison
+template <typename T>
+auto naive_mm(const Tensor<T, Device::CPU, 2> &a,
+              const Tensor<T, Device::CPU, 2> &b) {
+  const auto [I, K] = a.shape();
+  const auto J = b.shape()[1];
+  auto c = Tensor<T, Device::CPU, 2>(I, J);
+  for (std::size_t i = 0; i < I; ++i) {
+    for (std::size_t k = 0; k < K; ++k) {
+      for (std::size_t j = 0; j < J; ++j) {
+        c[i, j] += a[i, k] * b[k, j];
+      }
+    }
+  }
+  return c;
+}
+
+// Best of a few runs, in GFLOP/s
+template <typename Fn>
+auto gflops(std::size_t I, std::size_t K, std::size_t J, Fn &&fn,
+            int runs) -> double {
+  auto best = std::chrono::duration<double>::max();
+  for (int run = 0; run < runs; ++run) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    best = std::min<std::chrono::duration<double>>(
+        best, std::chrono::steady_clock::now() - start);
+  }
+  return 2.0 * static_cast<double>(I * K * J) / best.count() * 1e-9;
+}
+
+template <typename T>
+void benchmark(std::size_t I, std::size_t K, std::size_t J) {
+  auto a = Tensor<T, Device::CPU, 2>(I, K);
+  auto b = Tensor<T, Device::CPU, 2>(K, J);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    a.data()[i] = static_cast<T>(i % 7) / 7;
+  }
+  for (std::size_t i = 0; i < b.size(); ++i) {
+    b.data()[i] = static_cast<T>(i % 5) / 5;
+  }
+
+  const auto naive = gflops(I, K, J, [&] { return naive_mm(a, b); }, 1);
+  const auto blocked = gflops(I, K, J, [&] { return eager::mm(a, b); }, 5);
+  const auto parallel = gflops(
+      I, K, J, [&] { return eager::mm(execution::par, a, b); }, 5);
+  std::println("{:>5} x {:>5} x {:>5} {:>7}: naive {:7.2f} GFLOP/s, "
+               "mm {:7.2f} GFLOP/s ({:.0f}x), mm(par) {:7.2f} GFLOP/s on {} "
+               "threads",
+               I, K, J, sizeof(T) == 4 ? "float" : "double", naive, blocked,
+               blocked / naive, parallel, ThreadPool::instance().size());
+}
+
+// Many small products: one mm per matrix against a single batched matmul
+void batched_benchmark(std::size_t batch, std::size_t n) {
+  auto a = Tensor<float, Device::CPU, 3>(batch, n, n);
+  auto b = Tensor<float, Device::CPU, 3>(batch, n, n);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    a.data()[i] = static_cast<float>(i % 7) / 7;
+    b.data()[i] = static_cast<float>(i % 5) / 5;
+  }
+
+  const auto looped = gflops(
+      batch * n, n, n,
+      [&] {
+        auto x = Tensor<float, Device::CPU, 2>(n, n);
+        auto y = Tensor<float, Device::CPU, 2>(n, n);
+        for (std::size_t m = 0; m < batch; ++m) {
+          std::copy_n(a.data() + (m * n * n), n * n, x.data());
+          std::copy_n(b.data() + (m * n * n), n * n, y.data());
+          eager::mm(x, y);
+        }
+      },
+      3);
+  const auto batched =
+      gflops(batch * n, n, n, [&] { return eager::bmm(a, b); }, 3);
+  const auto parallel = gflops(
+      batch * n, n, n, [&] { return eager::bmm(execution::par, a, b); }, 3);
+  std::println("{:>5} x ({:>3} x {:>3} x {:>3})  float: looped mm {:7.2f} "
+               "GFLOP/s, bmm {:7.2f} GFLOP/s, bmm(par) {:7.2f} GFLOP/s",
+               batch, n, n, n, looped, batched, parallel);
+}
+
+auto main() -> int {
+  // Square
+  for (const std::size_t n : {128, 256, 512, 1024}) {
+    benchmark<float>(n, n, n);
+  }
+  benchmark<double>(512, 512, 512);
+
+  // Skinny: tall times thin, a long reduction, a matrix times a few
+  // vectors, and a small output over a very long K (split along K in
+  // parallel)
+  benchmark<float>(4096, 64, 4096);
+  benchmark<float>(64, 4096, 64);
+  benchmark<float>(1024, 1024, 16);
+  benchmark<float>(16, 1 << 20, 16);
+
+  // Matrix times vector and vector times matrix (batch size one inference)
+  benchmark<float>(4096, 4096, 1);
+  benchmark<float>(1, 4096, 4096);
+
+  // Batched, down to many 4 x 4 transforms (one matrix per SIMD lane)
+  batched_benchmark(1 << 16, 4);
+  batched_benchmark(4096, 16);
+  batched_benchmark(512, 64);
+}
@@ -20,6 +20,9 @@ auto main() -> int {
   auto w = venus::eager::where(x > 3, x, y);
   std::println("{}", w); // venus::Tensor([1.00, 1.00, 1.00, 4.00, 5.00, 6.00], shape=(3, 2))
 
+  auto f = venus::eager::where_gt(x, 3, x, y); // fused: no intermediate mask
+  std::println("{}", f); // venus::Tensor([1.00, 1.00, 1.00, 4.00, 5.00, 6.00], shape=(3, 2))
+
   auto k = venus::eager::where(x > 3, 2.0f, -1.0f);
   std::println("{}", k); // venus::Tensor([-1.00, -1.00, -1.00, 2.00, 2.00, 2.00], shape=(3, 2))
 
@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <venus/parallel/execution.hpp>
+#include <venus/parallel/thread_pool.hpp>
+
+using namespace venus;
+
+TEST_CASE("Thread pool covers the range exactly once", "[parallel][pool]") {
+  auto pool = ThreadPool(4);
+  REQUIRE(pool.size() == 4);
+
+  std::vector<int> hits(10'000, 0);
+  std::atomic<std::size_t> chunks{0};
+  pool.parallelFor(hits.size(), 100, [&](std::size_t begin, std::size_t end) {
+    ++chunks;
+    for (auto i = begin; i < end; ++i) {
+      ++hits[i];
+    }
+  });
+
+  REQUIRE(chunks == 4);
+  for (auto hit : hits) {
+    REQUIRE(hit == 1);
+  }
+}
+
+TEST_CASE("Thread pool respects the grain size", "[parallel][pool]") {
+  auto pool = ThreadPool(8);
+  std::atomic<std::size_t> chunks{0};
+  pool.parallelFor(250, 100, [&](std::size_t, std::size_t) { ++chunks; });
+  REQUIRE(chunks == 3);
+
+  chunks = 0;
+  pool.parallelFor(0, 1, [&](std::size_t, std::size_t) { ++chunks; });
+  REQUIRE(chunks == 0);
+}
+
+TEST_CASE("Nested parallel calls run on the calling thread",
+          "[parallel][pool]") {
+  auto pool = ThreadPool(4);
+  std::atomic<bool> nested_on_caller{true};
+
+  pool.parallelFor(4, 1, [&](std::size_t, std::size_t) {
+    const auto outer = std::this_thread::get_id();
+    pool.parallelFor(100, 1, [&](std::size_t, std::size_t) {
+      if (std::this_thread::get_id() != outer) {
+        nested_on_caller = false;
+      }
+    });
+  });
+
+  REQUIRE(nested_on_caller);
+}
+
+TEST_CASE("Thread pool rethrows chunk exceptions", "[parallel][pool]") {
+  auto pool = ThreadPool(4);
+  REQUIRE_THROWS_AS(pool.parallelFor(100, 1,
+                                     [](std::size_t begin, std::size_t) {
+                                       if (begin >= 50) {
+                                         throw std::runtime_error("chunk");
+                                       }
+                                     }),
+                    std::runtime_error);
+}
+
+TEST_CASE("Execution policies", "[parallel][policy]") {
+  STATIC_REQUIRE(execution::is_parallel_v<decltype(execution::par)>);
+  STATIC_REQUIRE(execution::is_parallel_v<decltype(execution::par_unseq)>);
+  STATIC_REQUIRE_FALSE(execution::is_parallel_v<decltype(execution::unseq)>);
+  STATIC_REQUIRE(execution::is_unsequenced_v<decltype(execution::unseq)>);
+  STATIC_REQUIRE_FALSE(execution::is_unsequenced_v<decltype(execution::seq)>);
+
+  std::atomic<std::size_t> chunks{0};
+  execution::for_each_chunk(execution::seq, 1'000'000,
+                            [&](std::size_t, std::size_t) { ++chunks; });
+  REQUIRE(chunks == 1);
+}
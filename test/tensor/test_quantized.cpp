@@ -0,0 +1,161 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <venus/memory/device.hpp>
+#include <venus/tensor/quantized.hpp>
+#include <venus/tensor/tensor.hpp>
+
+using namespace venus;
+
+TEST_CASE("Quantize and Dequantize", "[tensor][quantized]") {
+  SECTION("Per-tensor affine round trip") {
+    auto x = Tensor<float, Device::CPU, 1>{-1.0f, 0.0f, 0.5f, 1.0f, 3.0f};
+    const auto q = eager::quantize(x, 0.5f, 10);
+
+    REQUIRE_FALSE(q.perChannel());
+    REQUIRE(q.scale() == 0.5f);
+    REQUIRE(q.zeroPoint() == 10);
+    REQUIRE(q.values()[0] == 8);
+    REQUIRE(q.values()[1] == 10);
+    REQUIRE(q.values()[4] == 16);
+    REQUIRE(eager::equal(eager::dequantize(q), x));
+  }
+
+  SECTION("Round half to even and saturate") {
+    auto x = Tensor<float, Device::CPU, 1>{0.25f, 0.75f, 100.0f, -100.0f};
+    const auto q = eager::quantize(x, 0.5f);
+
+    REQUIRE(q.values()[0] == 0);
+    REQUIRE(q.values()[1] == 2);
+    REQUIRE(q.values()[2] == 127);
+    REQUIRE(q.values()[3] == -128);
+  }
+
+  SECTION("NaN maps to the zero point") {
+    auto x = Tensor<float, Device::CPU, 1>{
+        1.0f, std::numeric_limits<float>::quiet_NaN(), -1.0f};
+    const auto q = eager::quantize(x, 0.5f, -3);
+
+    REQUIRE(q.values()[0] == -1);
+    REQUIRE(q.values()[1] == -3);
+    REQUIRE(q.values()[2] == -5);
+  }
+
+  SECTION("Symmetric per-channel") {
+    const auto w = Tensor<float, Device::CPU, 2>{{1.0f, -2.0f, 0.5f},
+                                                 {4.0f, 1.0f, -0.5f}};
+    const auto q = eager::quantize_symmetric<1>(w);
+
+    REQUIRE(q.perChannel());
+    REQUIRE(q.axis() == 1);
+    REQUIRE(q.channels() == 3);
+    REQUIRE(q.values()[1, 0] == 127);
+    REQUIRE(q.values()[0, 1] == -127);
+    REQUIRE(q.values()[1, 2] == -127);
+
+    const auto restored = eager::dequantize(q);
+    for (std::size_t i = 0; i < 2; ++i) {
+      for (std::size_t j = 0; j < 3; ++j) {
+        REQUIRE(std::abs(restored[i, j] - w[i, j]) <= q.scale(j));
+      }
+    }
+  }
+
+  SECTION("Invalid parameters") {
+    auto values = Tensor<std::int8_t, Device::CPU, 1>(4);
+    REQUIRE_THROWS_AS((QuantizedTensor<Device::CPU, 1>(values, 0.0f)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS((QuantizedTensor<Device::CPU, 1>(values, 1.0f, 200)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS((QuantizedTensor<Device::CPU, 1>(
+                          values, Tensor<float, Device::CPU, 1>(3),
+                          Tensor<std::int32_t, Device::CPU, 1>(3), 0)),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Quantized Matrix Multiplication", "[tensor][quantized]") {
+  auto x = Tensor<float, Device::CPU, 2>{{1.0f, 2.0f, 3.0f},
+                                         {-1.0f, 0.0f, 4.0f}};
+  auto y = Tensor<float, Device::CPU, 2>{{1.0f, 0.0f},
+                                         {2.0f, -1.0f},
+                                         {0.0f, 3.0f}};
+  auto expected = Tensor<float, Device::CPU, 2>{{5.0f, 7.0f}, {-1.0f, 12.0f}};
+
+  SECTION("Zero points are folded out of the accumulators") {
+    const auto a = eager::quantize(x, 1.0f, 3);
+    const auto b = eager::quantize(y, 1.0f, -2);
+    const auto acc = eager::qmm(a, b);
+
+    STATIC_REQUIRE(
+        std::is_same_v<std::remove_cvref_t<decltype(acc)>::ElementType,
+                       std::int32_t>);
+    REQUIRE(acc[0, 0] == 5);
+    REQUIRE(acc[0, 1] == 7);
+    REQUIRE(acc[1, 0] == -1);
+    REQUIRE(acc[1, 1] == 12);
+  }
+
+  SECTION("Requantization epilogue") {
+    const auto a = eager::quantize(x, 0.5f);
+    const auto b = eager::quantize(y, 0.25f);
+
+    const auto out = eager::qmm(a, b, 1.0f, 5);
+    REQUIRE(out.values()[1, 1] == 17);
+    REQUIRE(eager::equal(eager::dequantize(out), expected));
+
+    const auto saturated = eager::qmm(a, b, 0.05f);
+    REQUIRE(saturated.values()[1, 1] == 127);
+  }
+
+  SECTION("Per-channel weights against an integer reference") {
+    // K spans a full vector step plus a tail, N spans a 4-column block plus
+    // leftovers
+    constexpr std::size_t M = 5;
+    constexpr std::size_t K = 70;
+    constexpr std::size_t N = 9;
+
+    auto lhs = Tensor<float, Device::CPU, 2>(M, K);
+    auto rhs = Tensor<float, Device::CPU, 2>(K, N);
+    for (std::size_t i = 0; i < M; ++i) {
+      for (std::size_t k = 0; k < K; ++k) {
+        lhs[i, k] = static_cast<float>(((i * 7) + (k * 3)) % 23) - 11.0f;
+      }
+    }
+    for (std::size_t k = 0; k < K; ++k) {
+      for (std::size_t j = 0; j < N; ++j) {
+        rhs[k, j] = static_cast<float>(((k * 5) + (j * 11)) % 31) - 15.0f;
+      }
+    }
+
+    auto scales = Tensor<float, Device::CPU, 1>(N);
+    auto zero_points = Tensor<std::int32_t, Device::CPU, 1>(N);
+    for (std::size_t j = 0; j < N; ++j) {
+      scales[j] = 1.0f;
+      zero_points[j] = static_cast<std::int32_t>(j) - 4;
+    }
+
+    const auto a = eager::quantize(lhs, 1.0f, -7);
+    const auto b = eager::quantize(rhs, scales, zero_points, 1);
+    const auto acc = eager::qmm(a, b);
+    const auto reference = eager::mm(lhs, rhs);
+
+    for (std::size_t i = 0; i < M; ++i) {
+      for (std::size_t j = 0; j < N; ++j) {
+        REQUIRE(acc[i, j] == static_cast<std::int32_t>(reference[i, j]));
+      }
+    }
+  }
+
+  SECTION("Unsupported layouts") {
+    const auto a = eager::quantize(x, 1.0f);
+    REQUIRE_THROWS_AS(eager::qmm(a, a), std::invalid_argument);
+
+    const auto per_column = eager::quantize_symmetric<1>(x);
+    const auto b = eager::quantize(y, 1.0f);
+    REQUIRE_THROWS_AS(eager::qmm(per_column, b), std::invalid_argument);
+  }
+}
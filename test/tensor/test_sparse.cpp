@@ -0,0 +1,205 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <venus/memory/device.hpp>
+#include <venus/parallel/execution.hpp>
+#include <venus/tensor/sparse.hpp>
+#include <venus/tensor/tensor.hpp>
+#include <vector>
+
+using namespace venus;
+
+namespace {
+
+// 97% zeros, with a few rows empty
+auto sparse_features(std::size_t rows, std::size_t cols) {
+  auto x = Tensor<float, Device::CPU, 2>(rows, cols);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    if ((i * 7919) % 31 == 0 and (i / cols) % 5 != 3) {
+      x.data()[i] = static_cast<float>(i % 13) - 6.0f;
+    }
+  }
+  return x;
+}
+
+} // namespace
+
+TEST_CASE("Sparse conversions", "[tensor][sparse]") {
+  const auto x = Tensor<int, Device::CPU, 2>{{0, 3, 0}, {0, 0, 0}, {5, 0, -1}};
+
+  SECTION("Dense to COO and CSR") {
+    const auto coo = eager::to_coo(x);
+    REQUIRE(coo.nnz() == 3);
+    REQUIRE(coo.rowIndices() == std::vector<std::size_t>{0, 2, 2});
+    REQUIRE(coo.colIndices() == std::vector<std::size_t>{1, 0, 2});
+    REQUIRE(coo.values() == std::vector<int>{3, 5, -1});
+
+    const auto csr = eager::to_csr(x);
+    REQUIRE(csr.rowOffsets() == std::vector<std::size_t>{0, 1, 1, 3});
+    REQUIRE(csr.colIndices() == std::vector<std::size_t>{1, 0, 2});
+    REQUIRE(eager::equal(eager::to_dense(csr), x));
+    REQUIRE(eager::equal(eager::to_dense(eager::to_coo(csr)), x));
+  }
+
+  SECTION("From nonzero indices") {
+    const auto coo = eager::to_coo(x, eager::nonzero(eager::gt(x, 0)));
+    REQUIRE(coo.nnz() == 2);
+    REQUIRE(coo.values() == std::vector<int>{3, 5});
+  }
+
+  SECTION("Unordered COO with repeated positions") {
+    const auto coo = CooTensor<int, Device::CPU>(
+        Shape<2>(2, 3), {1, 0, 1, 1}, {2, 1, 0, 2}, {4, 1, 2, 3});
+    const auto csr = eager::to_csr(coo);
+    REQUIRE(csr.rowOffsets() == std::vector<std::size_t>{0, 1, 3});
+    REQUIRE(csr.colIndices() == std::vector<std::size_t>{1, 0, 2});
+    REQUIRE(csr.values() == std::vector<int>{1, 2, 7});
+    REQUIRE(eager::equal(eager::to_dense(coo), eager::to_dense(csr)));
+  }
+
+  SECTION("Invalid structure") {
+    REQUIRE_THROWS_AS((CooTensor<int, Device::CPU>(Shape<2>(2, 2), {0, 2},
+                                                   {0, 0}, {1, 1})),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS((CsrTensor<int, Device::CPU>(Shape<2>(2, 2), {0, 2, 1},
+                                                   {0, 1}, {1, 1})),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS((CsrTensor<int, Device::CPU>(Shape<2>(2, 2), {0, 1, 2},
+                                                   {0, 2}, {1, 1})),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Sparse arithmetic", "[tensor][sparse]") {
+  const auto x = sparse_features(67, 45);
+  const auto csr = eager::to_csr(x);
+  REQUIRE(csr.nnz() > 0);
+  REQUIRE(csr.nnz() < x.size() / 20);
+
+  auto w = Tensor<float, Device::CPU, 2>(45, 19);
+  auto v = Tensor<float, Device::CPU, 1>(45);
+  auto d = Tensor<float, Device::CPU, 2>(67, 45);
+  for (std::size_t i = 0; i < w.size(); ++i) {
+    w.data()[i] = static_cast<float>(i % 9) - 4.0f;
+  }
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    v.data()[i] = static_cast<float>(i % 5) - 2.0f;
+  }
+  for (std::size_t i = 0; i < d.size(); ++i) {
+    d.data()[i] = static_cast<float>(i % 11);
+  }
+
+  SECTION("SpMM and SpMV match the dense products") {
+    const auto dense = eager::mm(x, w);
+    REQUIRE(eager::equal(eager::mm(csr, w), dense));
+    REQUIRE(eager::equal(eager::mm(execution::par, csr, w), dense));
+
+    const auto y = eager::mv(execution::par, csr, v);
+    REQUIRE(eager::equal(y, eager::mv(x, v)));
+    REQUIRE(eager::equal(eager::mv(csr, v), y));
+
+    REQUIRE_THROWS_AS(eager::mm(csr, d), std::invalid_argument);
+  }
+
+  SECTION("Elementwise with dense tensors") {
+    REQUIRE(eager::equal(eager::add(csr, d), eager::add(x, d)));
+    REQUIRE(eager::equal(eager::add(execution::par, d, csr), eager::add(d, x)));
+    REQUIRE(eager::equal(eager::sub(csr, d), eager::sub(x, d)));
+    REQUIRE(eager::equal(eager::sub(execution::par, d, csr), eager::sub(d, x)));
+
+    const auto product = eager::mul(execution::par, csr, d);
+    REQUIRE(product.nnz() == csr.nnz());
+    REQUIRE(eager::equal(eager::to_dense(product), eager::mul(x, d)));
+    REQUIRE(eager::equal(eager::to_dense(eager::mul(d, csr)),
+                         eager::mul(d, x)));
+
+    REQUIRE_THROWS_AS(eager::add(csr, w), std::invalid_argument);
+  }
+}
+
+TEST_CASE("2:4 structured sparsity", "[tensor][sparse]") {
+  auto w = Tensor<float, Device::CPU, 2>(37, 44);
+  auto x = Tensor<float, Device::CPU, 2>(44, 19);
+  auto b = Tensor<float, Device::CPU, 1>(37);
+  for (std::size_t i = 0; i < w.size(); ++i) {
+    w.data()[i] = static_cast<float>((i * 37) % 17) - 8.0f;
+  }
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    x.data()[i] = static_cast<float>(i % 7) - 3.0f;
+  }
+  for (std::size_t i = 0; i < b.size(); ++i) {
+    b.data()[i] = static_cast<float>(i % 3);
+  }
+  const auto sparse = eager::to_semi_structured(w);
+  const auto pruned = eager::to_dense(sparse);
+
+  SECTION("Pruning keeps the two largest entries of every group") {
+    const auto groups =
+        eager::to_semi_structured(Tensor<int, Device::CPU, 2>{
+            {1, -7, 3, 0, 4, 4, 4, 4}, {0, 0, 0, 0, 9, 0, 0, -2}});
+    REQUIRE(groups.nnz() == 8);
+    REQUIRE(groups.values() == std::vector<int>{-7, 3, 4, 4, 0, 0, 9, -2});
+    REQUIRE(eager::equal(eager::to_dense(groups),
+                         Tensor<int, Device::CPU, 2>{
+                             {0, -7, 3, 0, 4, 4, 0, 0},
+                             {0, 0, 0, 0, 9, 0, 0, -2}}));
+
+    REQUIRE(sparse.nnz() == w.size() / 2);
+    REQUIRE(eager::equal(eager::to_dense(eager::to_semi_structured(pruned)),
+                         pruned));
+  }
+
+  SECTION("Most negative integers and NaN are kept") {
+    constexpr auto lowest = std::numeric_limits<std::int8_t>::min();
+    const auto ints =
+        eager::to_semi_structured(Tensor<std::int8_t, Device::CPU, 2>{
+            {1, lowest, -2, 3}, {127, 0, lowest, 5}});
+    REQUIRE(ints.values() ==
+            std::vector<std::int8_t>{lowest, 3, 127, lowest});
+
+    constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+    const auto floats = eager::to_semi_structured(
+        Tensor<float, Device::CPU, 2>{{1.0f, nan, 5.0f, -2.0f},
+                                      {nan, 9.0f, nan, 2.0f}});
+    const auto &values = floats.values();
+    REQUIRE(std::isnan(values[0]));
+    REQUIRE(values[1] == 5.0f);
+    REQUIRE(std::isnan(values[2]));
+    REQUIRE(std::isnan(values[3]));
+  }
+
+  SECTION("MatMul and linear match the pruned dense weight") {
+    const auto dense = eager::mm(pruned, x);
+    REQUIRE(eager::equal(eager::mm(sparse, x), dense));
+    REQUIRE(eager::equal(eager::mm(execution::par, sparse, x), dense));
+
+    auto inputs = Tensor<float, Device::CPU, 2>(19, 44);
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+      inputs.data()[i] = static_cast<float>(i % 5) - 2.0f;
+    }
+    REQUIRE(eager::equal(
+        eager::linear(execution::par, inputs, sparse, b,
+                      eager::Activation::relu),
+        eager::linear(inputs, pruned, b, eager::Activation::relu)));
+
+    auto input = Tensor<float, Device::CPU, 1>(44);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+      input.data()[i] = static_cast<float>(i % 9) - 4.0f;
+    }
+    REQUIRE(eager::equal(eager::linear(input, sparse, b),
+                         eager::linear(input, pruned, b)));
+  }
+
+  SECTION("Invalid structure") {
+    REQUIRE_THROWS_AS(
+        eager::to_semi_structured(Tensor<float, Device::CPU, 2>(2, 6)),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS((SemiStructuredTensor<int, Device::CPU>(
+                          Shape<2>(1, 4), {1, 2}, {0b0101})),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(eager::mm(sparse, w), std::invalid_argument);
+  }
+}
@@ -1,8 +1,11 @@
 #include "catch2/catch_template_test_macros.hpp"
 #include <cassert>
+#include <cmath>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
+#include <array>
 #include <functional>
+#include <limits>
 #include <venus/memory/device.hpp>
 
 #include <tuple>
@@ -113,6 +116,35 @@ TEST_CASE("Tensor Ops", "[tensor][ops]") {
     REQUIRE(tensor[2, 2] == 27.0f); // 9 * 3
   }
 
+  SECTION("Tensor Transform (execution policies)") {
+    // Large enough to be split into several chunks by the parallel policies
+    auto tensor = Tensor<int, Device::CPU, 2>(300, 1000);
+    tensor.iota(0);
+    const auto expected =
+        venus::eager::transform(tensor, [](int t) { return t % 7 == 0; });
+
+    auto seq = venus::eager::transform(venus::execution::seq, tensor,
+                                       [](int t) { return t % 7 == 0; });
+    auto par = venus::eager::transform(venus::execution::par, tensor,
+                                       [](int t) { return t % 7 == 0; });
+    auto par_unseq = venus::eager::transform(
+        venus::execution::par_unseq, tensor, [](int t) { return t % 7 == 0; });
+
+    STATIC_REQUIRE(std::is_same_v<decltype(par)::ElementType, bool>);
+    REQUIRE(venus::eager::equal(seq, expected));
+    REQUIRE(venus::eager::equal(par, expected));
+    REQUIRE(venus::eager::equal(par_unseq, expected));
+
+    tensor.transform(venus::execution::par_unseq, [](int t) { return t * 3; });
+    REQUIRE(tensor[0, 1] == 3);
+    REQUIRE(tensor[299, 999] == 899'997);
+
+    auto view = tensor.view();
+    REQUIRE_THROWS_AS(tensor.transform(venus::execution::par,
+                                       [](int t) { return t; }),
+                      std::runtime_error);
+  }
+
   SECTION("Dot product") {
     auto x = Tensor<int, Device::CPU, 1>(3);
     auto y = Tensor<float, Device::CPU, 1>(3);
@@ -150,6 +182,492 @@ TEST_CASE("Tensor Ops", "[tensor][ops]") {
     REQUIRE(venus::eager::equal(C, expected));
   }
 
+  SECTION("Matrix Multiplication across tile and block edges") {
+    // Shapes that are not multiples of any register tile, and a depth that
+    // spans several k blocks
+    for (const auto [I, K, J] : {std::array<std::size_t, 3>{37, 71, 53},
+                                 std::array<std::size_t, 3>{5, 1000, 130},
+                                 std::array<std::size_t, 3>{300, 3, 1}}) {
+      auto A = Tensor<int, Device::CPU, 2>(I, K);
+      auto B = Tensor<double, Device::CPU, 2>(K, J);
+      for (std::size_t i = 0; i < A.size(); ++i) {
+        A.data()[i] = static_cast<int>((i * 37) % 17) - 8;
+      }
+      for (std::size_t i = 0; i < B.size(); ++i) {
+        B.data()[i] = static_cast<double>((i * 11) % 13) - 6;
+      }
+
+      auto expected = Tensor<double, Device::CPU, 2>(I, J);
+      for (std::size_t i = 0; i < I; ++i) {
+        for (std::size_t k = 0; k < K; ++k) {
+          for (std::size_t j = 0; j < J; ++j) {
+            expected[i, j] += A[i, k] * B[k, j];
+          }
+        }
+      }
+
+      REQUIRE(venus::eager::equal(venus::eager::mm(A, B), expected));
+      REQUIRE(venus::eager::equal(
+          venus::eager::mm(A, venus::eager::cast<int>(B)),
+          venus::eager::cast<int>(expected)));
+    }
+  }
+
+  SECTION("Parallel Matrix Multiplication matches sequential") {
+    // Square, tall, wide, and skinny-wide (split along K) shapes
+    for (const auto [I, K, J] : {std::array<std::size_t, 3>{300, 200, 300},
+                                 std::array<std::size_t, 3>{3000, 100, 5},
+                                 std::array<std::size_t, 3>{5, 100, 3000},
+                                 std::array<std::size_t, 3>{4, 100'000, 4}}) {
+      auto A = Tensor<float, Device::CPU, 2>(I, K);
+      auto B = Tensor<float, Device::CPU, 2>(K, J);
+      for (std::size_t i = 0; i < A.size(); ++i) {
+        A.data()[i] = static_cast<float>((i * 37) % 17) / 3.0f - 2.0f;
+      }
+      for (std::size_t i = 0; i < B.size(); ++i) {
+        B.data()[i] = static_cast<float>((i * 11) % 13) / 7.0f - 1.0f;
+      }
+      const auto parallel = venus::eager::mm(venus::execution::par, A, B);
+      REQUIRE(venus::eager::equal(venus::eager::mm(A, B), parallel));
+    }
+  }
+
+  SECTION("Matrix Multiplication with transposed operands") {
+    const auto transposed = [](const auto &t) {
+      const auto [rows, cols] = t.shape();
+      auto result = Tensor<float, Device::CPU, 2>(cols, rows);
+      for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+          result[j, i] = t[i, j];
+        }
+      }
+      return result;
+    };
+
+    // General, matrix-vector, vector-matrix and outer product shapes
+    for (const auto [I, K, J] : {std::array<std::size_t, 3>{37, 71, 53},
+                                 std::array<std::size_t, 3>{37, 71, 1},
+                                 std::array<std::size_t, 3>{1, 71, 53},
+                                 std::array<std::size_t, 3>{37, 1, 53}}) {
+      auto A = Tensor<float, Device::CPU, 2>(I, K);
+      auto B = Tensor<float, Device::CPU, 2>(K, J);
+      for (std::size_t i = 0; i < A.size(); ++i) {
+        A.data()[i] = static_cast<float>((i * 7) % 11) - 5.0f;
+      }
+      for (std::size_t i = 0; i < B.size(); ++i) {
+        B.data()[i] = static_cast<float>((i * 5) % 13) / 4.0f;
+      }
+      const auto At = transposed(A);
+      const auto Bt = transposed(B);
+      const auto expected = venus::eager::mm(A, B);
+
+      REQUIRE(venus::eager::equal(
+          venus::eager::mm(At, B, venus::eager::trans_a), expected));
+      REQUIRE(venus::eager::equal(
+          venus::eager::mm(A, Bt, venus::eager::trans_b), expected));
+      REQUIRE(venus::eager::equal(
+          venus::eager::mm(venus::execution::par, At, Bt,
+                           venus::eager::trans_a, venus::eager::trans_b),
+          expected));
+    }
+
+    // Attention scores, queries times keys as stored
+    auto Q = Tensor<float, Device::CPU, 3>(2, 5, 8);
+    auto Keys = Tensor<float, Device::CPU, 3>(2, 7, 8);
+    for (std::size_t i = 0; i < Q.size(); ++i) {
+      Q.data()[i] = static_cast<float>(i % 9) - 4.0f;
+    }
+    for (std::size_t i = 0; i < Keys.size(); ++i) {
+      Keys.data()[i] = static_cast<float>((i * 3) % 7) - 3.0f;
+    }
+    const auto scores = venus::eager::bmm(Q, Keys, venus::eager::trans_b);
+    REQUIRE(scores.shape() == Shape<3>(2, 5, 7));
+    for (std::size_t b = 0; b < 2; ++b) {
+      for (std::size_t i = 0; i < 5; ++i) {
+        for (std::size_t j = 0; j < 7; ++j) {
+          float expected = 0.0f;
+          for (std::size_t k = 0; k < 8; ++k) {
+            expected += Q[b, i, k] * Keys[b, j, k];
+          }
+          REQUIRE(scores[b, i, j] == expected);
+        }
+      }
+    }
+
+    REQUIRE_THROWS_AS(
+        venus::eager::mm(Tensor<float, Device::CPU, 2>(3, 4),
+                         Tensor<float, Device::CPU, 2>(4, 5),
+                         venus::eager::trans_a),
+        std::invalid_argument);
+  }
+
+  SECTION("Linear layers with fused epilogues") {
+    const auto reference = [](venus::eager::Activation activation, double v) {
+      switch (activation) {
+      case venus::eager::Activation::relu:
+        return v > 0.0 ? v : 0.0;
+      case venus::eager::Activation::gelu: {
+        const auto u = 0.7978845608028654 * (v + (0.044715 * v * v * v));
+        return 0.5 * v * (1.0 + std::tanh(u));
+      }
+      case venus::eager::Activation::silu:
+        return v / (1.0 + std::exp(-v));
+      default:
+        return v;
+      }
+    };
+
+    // A batch of rows through the GEMM, and a single row through GEMV
+    for (const std::size_t rows : {std::size_t{29}, std::size_t{1}}) {
+      auto x = Tensor<float, Device::CPU, 3>(rows, 1, 45);
+      auto W = Tensor<float, Device::CPU, 2>(38, 45);
+      auto b = Tensor<float, Device::CPU, 1>(38);
+      auto residual = Tensor<float, Device::CPU, 3>(rows, 1, 38);
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        x.data()[i] = static_cast<float>((i * 7) % 11) / 8.0f - 0.6f;
+      }
+      for (std::size_t i = 0; i < W.size(); ++i) {
+        W.data()[i] = static_cast<float>((i * 5) % 13) / 32.0f - 0.2f;
+      }
+      for (std::size_t i = 0; i < b.size(); ++i) {
+        b.data()[i] = static_cast<float>(i % 5) / 4.0f - 0.5f;
+      }
+      for (std::size_t i = 0; i < residual.size(); ++i) {
+        residual.data()[i] = static_cast<float>(i % 3);
+      }
+
+      for (const auto activation :
+           {venus::eager::Activation::none, venus::eager::Activation::relu,
+            venus::eager::Activation::gelu, venus::eager::Activation::silu}) {
+        const auto y = venus::eager::linear(x, W, b, activation);
+        const auto z = venus::eager::linear(venus::execution::par, x, W, b,
+                                            activation, residual);
+        REQUIRE(y.shape() == Shape<3>(rows, 1, 38));
+        for (std::size_t i = 0; i < rows; ++i) {
+          for (std::size_t j = 0; j < 38; ++j) {
+            double dot = b[j];
+            for (std::size_t k = 0; k < 45; ++k) {
+              dot += static_cast<double>(x[i, 0, k]) * W[j, k];
+            }
+            const auto expected = reference(activation, dot);
+            REQUIRE(std::abs(y[i, 0, j] - expected) < 1e-5);
+            REQUIRE(std::abs(z[i, 0, j] - (expected + residual[i, 0, j])) <
+                    1e-5);
+          }
+        }
+      }
+    }
+
+    // Integer layers round the activation to the nearest integer
+    auto xi = Tensor<int, Device::CPU, 2>(7, 12);
+    auto Wi = Tensor<int, Device::CPU, 2>(9, 12);
+    auto bi = Tensor<int, Device::CPU, 1>(9);
+    for (std::size_t i = 0; i < xi.size(); ++i) {
+      xi.data()[i] = static_cast<int>((i * 7) % 5) - 2;
+    }
+    for (std::size_t i = 0; i < Wi.size(); ++i) {
+      Wi.data()[i] = static_cast<int>((i * 3) % 7) - 3;
+    }
+    for (std::size_t i = 0; i < bi.size(); ++i) {
+      bi.data()[i] = static_cast<int>(i % 4) - 1;
+    }
+    for (const auto activation :
+         {venus::eager::Activation::none, venus::eager::Activation::relu,
+          venus::eager::Activation::gelu, venus::eager::Activation::silu}) {
+      const auto y = venus::eager::linear(xi, Wi, bi, activation);
+      for (std::size_t i = 0; i < 7; ++i) {
+        for (std::size_t j = 0; j < 9; ++j) {
+          int dot = bi[j];
+          for (std::size_t k = 0; k < 12; ++k) {
+            dot += xi[i, k] * Wi[j, k];
+          }
+          REQUIRE(y[i, j] == static_cast<int>(std::round(
+                                 reference(activation, dot))));
+        }
+      }
+    }
+
+    auto A = Tensor<float, Device::CPU, 2>(23, 31);
+    auto B = Tensor<float, Device::CPU, 2>(31, 17);
+    auto C = Tensor<float, Device::CPU, 2>(23, 17);
+    for (std::size_t i = 0; i < A.size(); ++i) {
+      A.data()[i] = static_cast<float>((i * 3) % 7) - 3.0f;
+    }
+    for (std::size_t i = 0; i < B.size(); ++i) {
+      B.data()[i] = static_cast<float>(i % 5) - 2.0f;
+    }
+    for (std::size_t i = 0; i < C.size(); ++i) {
+      C.data()[i] = static_cast<float>(i % 9);
+    }
+    REQUIRE(venus::eager::equal(
+        venus::eager::addmm(C, A, B, 0.5f),
+        venus::eager::add(C, venus::eager::mul(venus::eager::mm(A, B), 0.5f))));
+
+    REQUIRE_THROWS_AS(
+        venus::eager::linear(A, Tensor<float, Device::CPU, 2>(4, 30),
+                             Tensor<float, Device::CPU, 1>(4)),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        venus::eager::linear(A, Tensor<float, Device::CPU, 2>(4, 31),
+                             Tensor<float, Device::CPU, 1>(5)),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(venus::eager::addmm(A, A, B, 1.0f),
+                      std::invalid_argument);
+  }
+
+  SECTION("Matrix-vector and outer products") {
+    // Enough rows and columns for full SIMD groups and ragged edges
+    auto A = Tensor<float, Device::CPU, 2>(37, 101);
+    auto x = Tensor<float, Device::CPU, 1>(101);
+    auto y = Tensor<float, Device::CPU, 1>(37);
+    for (std::size_t i = 0; i < A.size(); ++i) {
+      A.data()[i] = static_cast<float>((i * 7) % 11) - 5.0f;
+    }
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      x.data()[i] = static_cast<float>((i * 5) % 13) - 6.0f;
+    }
+    for (std::size_t i = 0; i < y.size(); ++i) {
+      y.data()[i] = static_cast<float>(i % 4) + 0.5f;
+    }
+
+    const auto Ax = venus::eager::mv(A, x);
+    const auto yA = venus::eager::vm(venus::execution::par, y, A);
+    const auto xy = venus::eager::outer(x, y);
+    REQUIRE(Ax.shape() == Shape<1>(37));
+    REQUIRE(yA.shape() == Shape<1>(101));
+    REQUIRE(xy.shape() == Shape<2>(101, 37));
+    for (std::size_t i = 0; i < 37; ++i) {
+      float expected = 0.0f;
+      for (std::size_t k = 0; k < 101; ++k) {
+        expected += A[i, k] * x[k];
+      }
+      REQUIRE(Ax[i] == expected);
+    }
+    for (std::size_t j = 0; j < 101; ++j) {
+      float expected = 0.0f;
+      for (std::size_t k = 0; k < 37; ++k) {
+        expected += y[k] * A[k, j];
+      }
+      REQUIRE(yA[j] == expected);
+      for (std::size_t i = 0; i < 37; ++i) {
+        REQUIRE(xy[j, i] == x[j] * y[i]);
+      }
+    }
+    REQUIRE(venus::eager::equal(venus::eager::ger(x, y), xy));
+
+    // mm with a unit dimension takes the same kernels
+    REQUIRE(venus::eager::equal(venus::eager::mm(A, x.reshape(101, 1)),
+                                Ax.reshape(37, 1)));
+    REQUIRE(venus::eager::equal(venus::eager::mm(y.reshape(1, 37), A),
+                                yA.reshape(1, 101)));
+    REQUIRE(venus::eager::equal(
+        venus::eager::mm(x.reshape(101, 1), y.reshape(1, 37)), xy));
+
+    REQUIRE_THROWS_AS(venus::eager::mv(A, y), std::invalid_argument);
+    REQUIRE_THROWS_AS(venus::eager::vm(x, A), std::invalid_argument);
+  }
+
+  SECTION("Batched Matrix Multiplication with broadcasting") {
+    auto A = Tensor<int, Device::CPU, 4>(2, 3, 4, 5);
+    auto B = Tensor<double, Device::CPU, 3>(3, 5, 6);
+    auto W = Tensor<double, Device::CPU, 2>(5, 6);
+    auto C = Tensor<int, Device::CPU, 4>(2, 1, 6, 4);
+    for (std::size_t i = 0; i < A.size(); ++i) {
+      A.data()[i] = static_cast<int>((i * 7) % 11) - 5;
+    }
+    for (std::size_t i = 0; i < B.size(); ++i) {
+      B.data()[i] = static_cast<double>((i * 5) % 13) / 4.0;
+    }
+    for (std::size_t i = 0; i < W.size(); ++i) {
+      W.data()[i] = static_cast<double>(i % 9) - 4.0;
+    }
+    for (std::size_t i = 0; i < C.size(); ++i) {
+      C.data()[i] = static_cast<int>(i % 5);
+    }
+
+    const auto AB = venus::eager::matmul(A, B);
+    const auto AW = venus::eager::matmul(A, W);
+    const auto ABC = venus::eager::matmul(venus::execution::par, AB, C);
+    REQUIRE(AB.shape() == Shape<4>(2, 3, 4, 6));
+    REQUIRE(AW.shape() == Shape<4>(2, 3, 4, 6));
+    REQUIRE(ABC.shape() == Shape<4>(2, 3, 4, 4));
+
+    for (std::size_t n = 0; n < 2; ++n) {
+      for (std::size_t h = 0; h < 3; ++h) {
+        for (std::size_t i = 0; i < 4; ++i) {
+          for (std::size_t j = 0; j < 6; ++j) {
+            double expected_b = 0.0;
+            double expected_w = 0.0;
+            for (std::size_t k = 0; k < 5; ++k) {
+              expected_b += A[n, h, i, k] * B[h, k, j];
+              expected_w += A[n, h, i, k] * W[k, j];
+            }
+            REQUIRE(AB[n, h, i, j] == expected_b);
+            REQUIRE(AW[n, h, i, j] == expected_w);
+          }
+          for (std::size_t j = 0; j < 4; ++j) {
+            double expected = 0.0;
+            for (std::size_t k = 0; k < 6; ++k) {
+              expected += AB[n, h, i, k] * C[n, 0, k, j];
+            }
+            REQUIRE(ABC[n, h, i, j] == expected);
+          }
+        }
+      }
+    }
+
+    auto X = Tensor<float, Device::CPU, 3>(8, 3, 4);
+    auto Y = Tensor<float, Device::CPU, 3>(8, 4, 2);
+    X.fill(1.5f);
+    Y.fill(2.0f);
+    const auto XY = venus::eager::bmm(X, Y);
+    REQUIRE(XY.shape() == Shape<3>(8, 3, 2));
+    for (std::size_t i = 0; i < XY.size(); ++i) {
+      REQUIRE(XY.data()[i] == 12.0f);
+    }
+
+    REQUIRE_THROWS_AS(venus::eager::bmm(X, Tensor<float, Device::CPU, 3>(4, 4,
+                                                                         2)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(venus::eager::matmul(A, Tensor<double, Device::CPU, 3>(
+                                                  2, 5, 6)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(venus::eager::matmul(A, Tensor<double, Device::CPU, 3>(
+                                                  3, 4, 6)),
+                      std::invalid_argument);
+  }
+
+  SECTION("Batched small matrices") {
+    auto M = Tensor<double, Device::CPU, 3>(37, 4, 4);
+    for (std::size_t i = 0; i < M.size(); ++i) {
+      M.data()[i] = static_cast<double>((i * 7) % 11) / 4.0 - 1.0;
+    }
+    for (std::size_t n = 0; n < 37; ++n) {
+      for (std::size_t i = 0; i < 4; ++i) {
+        M[n, i, i] += 6.0;
+      }
+    }
+
+    // Square products of up to 4 x 4 take the one-matrix-per-lane kernels
+    const auto Inv = venus::eager::inverse(venus::execution::par, M);
+    const auto Identity = venus::eager::bmm(M, Inv);
+    const auto dets = venus::eager::det(M);
+    const auto inv_dets = venus::eager::det(venus::execution::par, Inv);
+    for (std::size_t n = 0; n < 37; ++n) {
+      for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+          REQUIRE(std::abs(Identity[n, i, j] - (i == j ? 1.0 : 0.0)) < 1e-12);
+        }
+      }
+      REQUIRE(std::abs((dets[n] * inv_dets[n]) - 1.0) < 1e-12);
+    }
+
+    auto T = Tensor<int, Device::CPU, 3>(20, 3, 3);
+    auto U = Tensor<int, Device::CPU, 3>(1, 3, 3);
+    for (std::size_t i = 0; i < T.size(); ++i) {
+      T.data()[i] = static_cast<int>((i * 5) % 7) - 3;
+    }
+    for (std::size_t i = 0; i < U.size(); ++i) {
+      U.data()[i] = static_cast<int>(i) - 4;
+    }
+    const auto TU = venus::eager::matmul(T, U, venus::eager::trans_b);
+    const auto det_t = venus::eager::det(T);
+    for (std::size_t n = 0; n < 20; ++n) {
+      for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+          int expected = 0;
+          for (std::size_t k = 0; k < 3; ++k) {
+            expected += T[n, i, k] * U[0, j, k];
+          }
+          REQUIRE(TU[n, i, j] == expected);
+        }
+      }
+      REQUIRE(det_t[n] == (T[n, 0, 0] * (T[n, 1, 1] * T[n, 2, 2] -
+                                         T[n, 1, 2] * T[n, 2, 1])) -
+                              (T[n, 0, 1] * (T[n, 1, 0] * T[n, 2, 2] -
+                                             T[n, 1, 2] * T[n, 2, 0])) +
+                              (T[n, 0, 2] * (T[n, 1, 0] * T[n, 2, 1] -
+                                             T[n, 1, 1] * T[n, 2, 0])));
+    }
+
+    // Scale by 2 and translate by (1, 2, 3), then a perspective divide by z
+    auto Affine = Tensor<float, Device::CPU, 3>(1, 4, 4);
+    auto Projection = Tensor<float, Device::CPU, 3>(1, 4, 4);
+    Affine.fill(0.0f);
+    Projection.fill(0.0f);
+    for (std::size_t i = 0; i < 3; ++i) {
+      Affine[0, i, i] = 2.0f;
+      Affine[0, i, 3] = static_cast<float>(i + 1);
+      Projection[0, i, i] = 1.0f;
+    }
+    Affine[0, 3, 3] = 1.0f;
+    Projection[0, 3, 2] = 1.0f;
+
+    auto P = Tensor<float, Device::CPU, 2>(21, 3);
+    for (std::size_t i = 0; i < P.size(); ++i) {
+      P.data()[i] = static_cast<float>(i % 8) + 1.0f;
+    }
+    const auto moved = venus::eager::transform_points(Affine, P);
+    const auto projected =
+        venus::eager::transform_points(venus::execution::par, Projection, P);
+    for (std::size_t n = 0; n < 21; ++n) {
+      for (std::size_t i = 0; i < 3; ++i) {
+        REQUIRE(moved[n, i] == (2.0f * P[n, i]) + static_cast<float>(i + 1));
+        REQUIRE(projected[n, i] == P[n, i] / P[n, 2]);
+      }
+    }
+
+    auto H = Tensor<float, Device::CPU, 2>(21, 4);
+    H.fill(1.0f);
+    const auto homogeneous = venus::eager::transform_points(Affine, H);
+    REQUIRE(homogeneous[20, 2] == 5.0f);
+    REQUIRE(homogeneous[20, 3] == 1.0f);
+
+    REQUIRE_THROWS_AS(
+        venus::eager::det(Tensor<double, Device::CPU, 3>(2, 5, 5)),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        venus::eager::inverse(Tensor<double, Device::CPU, 3>(2, 3, 4)),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(venus::eager::transform_points(
+                          Affine, Tensor<float, Device::CPU, 2>(21, 2)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(venus::eager::transform_points(
+                          Tensor<float, Device::CPU, 3>(3, 4, 4), P),
+                      std::invalid_argument);
+  }
+
+  SECTION("Half Precision Tensors") {
+    auto x = Tensor<float16, Device::CPU, 2>(2, 3);
+    auto y = Tensor<bfloat16, Device::CPU, 2>(3, 2);
+    x.iota(1);
+    y.fill(2);
+
+    auto doubled = x + x;
+    STATIC_REQUIRE(std::is_same_v<decltype(doubled)::ElementType, float16>);
+    REQUIRE(static_cast<float>(doubled[1, 2]) == 12.0f);
+
+    auto widened = venus::eager::cast<float>(x);
+    STATIC_REQUIRE(std::is_same_v<decltype(widened)::ElementType, float>);
+    REQUIRE(widened[1, 0] == 4.0f);
+    REQUIRE(venus::eager::equal(venus::eager::cast<float16>(widened), x));
+
+    // fp32 accumulation: 2048 + 1 + 1 is not representable step by step in
+    // binary16, but the fp32 sum rounds to 2050
+    auto big = Tensor<float16, Device::CPU, 1>{float16(2048), float16(1),
+                                               float16(1)};
+    auto ones = Tensor<float16, Device::CPU, 1>{float16(1), float16(1),
+                                                float16(1)};
+    REQUIRE(big.dot(ones).value() == 2050);
+    auto summed = venus::eager::sum_dim<0>(big);
+    REQUIRE(static_cast<float>(summed[0]) == 2050.0f);
+
+    auto product = venus::eager::mm(x, venus::eager::cast<float16>(y));
+    STATIC_REQUIRE(std::is_same_v<decltype(product)::ElementType, float16>);
+    REQUIRE(static_cast<float>(product[0, 0]) == 12.0f); // (1 + 2 + 3) * 2
+    REQUIRE(static_cast<float>(product[1, 1]) == 30.0f); // (4 + 5 + 6) * 2
+  }
+
   SECTION("Nonzero / Where (1D)") {
     auto x = Tensor<int, Device::CPU, 1>{0, 5, 0, 3, 0};
     auto y = venus::eager::nonzero(x);
@@ -237,6 +755,92 @@ TEST_CASE("Tensor Ops", "[tensor][ops]") {
     }
   }
 
+  SECTION("Where - Fused Compare") {
+    auto x = Tensor<float, Device::CPU, 2>(3, 2);
+    auto y = Tensor<float, Device::CPU, 2>(3, 2);
+
+    x.iota(1);
+    y.fill(1);
+
+    auto z = venus::eager::where_gt(x, 3, x, y);
+
+    STATIC_REQUIRE(std::is_same_v<decltype(z)::ElementType, float>);
+    REQUIRE(venus::eager::equal(z, venus::eager::where(x > 3, x, y)));
+
+    auto k = venus::eager::where_lte(x, 3, 2.0f, -1.0f);
+    REQUIRE(venus::eager::equal(k, venus::eager::where(x <= 3, 2.0f, -1.0f)));
+
+    auto l = venus::eager::where_neq(x, y, y, -1.0f);
+    REQUIRE(venus::eager::equal(l, venus::eager::where(x != y, y, -1.0f)));
+  }
+
+  SECTION("Where - Fused Compare (Broadcasting)") {
+    auto x = Tensor<int, Device::CPU, 2>(3, 4);
+    auto row = Tensor<int, Device::CPU, 2>(1, 4);
+    auto col = Tensor<int, Device::CPU, 2>(3, 1);
+
+    x.iota(0);
+    row.iota(4);
+    col.fill(-1);
+
+    auto z = venus::eager::where_lt(x, row, x, col);
+
+    REQUIRE(z.shape() == x.shape());
+    for (std::size_t i = 0; i < 3; ++i) {
+      for (std::size_t j = 0; j < 4; ++j) {
+        REQUIRE(z[i, j] == (x[i, j] < row[0, j] ? x[i, j] : -1));
+      }
+    }
+  }
+
+  SECTION("BLAS Level 1 (in-place)") {
+    auto x = Tensor<float, Device::CPU, 2>(3, 2);
+    auto y = Tensor<float, Device::CPU, 2>(3, 2);
+    x.iota(1); // 1 .. 6
+    y.fill(10);
+
+    venus::eager::axpy(2, x, y);
+    REQUIRE(y[0, 0] == 12.0f);
+    REQUIRE(y[2, 1] == 22.0f);
+
+    venus::eager::axpby(venus::execution::par, 1.0f, x, 0.5f, y);
+    REQUIRE(y[0, 0] == 7.0f);  // 1 + 12 / 2
+    REQUIRE(y[2, 1] == 17.0f); // 6 + 22 / 2
+
+    venus::eager::scal(-1, x);
+    REQUIRE(x[1, 0] == -3.0f);
+
+    auto ints = Tensor<int, Device::CPU, 1>{1, 2, 3};
+    venus::eager::axpy(0.5f, Tensor<int, Device::CPU, 1>{4, 4, 4}, ints);
+    REQUIRE(ints[2] == 5);
+
+    auto wrong = Tensor<float, Device::CPU, 2>(2, 3);
+    REQUIRE_THROWS_AS(venus::eager::axpy(1, wrong, y), std::invalid_argument);
+
+    auto view = y.view();
+    REQUIRE_THROWS_AS(venus::eager::scal(2, y), std::runtime_error);
+  }
+
+  SECTION("Fused Multiply-Add and Lerp") {
+    auto a = Tensor<float, Device::CPU, 2>(2, 3);
+    auto b = Tensor<float, Device::CPU, 2>(1, 3);
+    a.iota(1);
+    b.fill(2);
+
+    auto f = venus::eager::fma(a, b, 1.0f);
+    REQUIRE(f.shape() == a.shape());
+    REQUIRE(venus::eager::equal(f, a * b + 1.0f));
+
+    auto l = venus::eager::lerp(a, b, 0.25f);
+    REQUIRE(l[0, 0] == 1.25f); // 1 + 0.25 * (2 - 1)
+    REQUIRE(l[1, 2] == 5.0f);  // 6 + 0.25 * (2 - 6)
+
+    auto halves = Tensor<float16, Device::CPU, 1>{float16(1), float16(3)};
+    auto blended = venus::eager::lerp(halves, 2.0f, 0.5f);
+    STATIC_REQUIRE(std::is_same_v<decltype(blended)::ElementType, float>);
+    REQUIRE(blended[1] == 2.5f);
+  }
+
   SECTION("Broadcasting") {
     // clang-format off
     auto a = Tensor<int, Device::CPU, 2>{{
@@ -341,6 +945,590 @@ TEST_CASE("Sum across multiple dimensions", "[tensor][ops][sum_dims]") {
   }
 }
 
+TEST_CASE("Reductions", "[tensor][ops][reduce]") {
+  auto tensor = Tensor<int, Device::CPU, 3>(2, 3, 4);
+  tensor.iota(1);
+
+  SECTION("Keepdim and squeeze") {
+    auto rows = venus::eager::sum<2>(tensor);
+    REQUIRE(rows.shape() == Shape(2, 3, 1));
+    REQUIRE(rows[0, 0, 0] == 1 + 2 + 3 + 4);
+
+    auto squeezed = venus::eager::sum<2>(tensor, venus::eager::squeeze);
+    REQUIRE(squeezed.shape() == Shape(2, 3));
+    REQUIRE(squeezed[1, 2] == 21 + 22 + 23 + 24);
+
+    // Non-adjacent axes in a single pass
+    auto outer = venus::eager::sum<0, 2>(tensor, venus::eager::squeeze);
+    REQUIRE(outer.shape() == Shape(3));
+    REQUIRE(outer[0] == (1 + 2 + 3 + 4) + (13 + 14 + 15 + 16));
+    REQUIRE(venus::eager::equal(venus::eager::sum<0, 2>(tensor),
+                                venus::eager::sum_dims<0, 2>(tensor)));
+  }
+
+  SECTION("Full reduction") {
+    auto total = venus::eager::sum(tensor);
+    STATIC_REQUIRE(decltype(total)::rank == 0);
+    REQUIRE(total.value() == 300);
+    REQUIRE(venus::eager::prod(Tensor<int, Device::CPU, 1>{2, 3, 4}).value() ==
+            24);
+  }
+
+  SECTION("Mean, max and min") {
+    auto mean = venus::eager::mean<1>(tensor, venus::eager::squeeze);
+    STATIC_REQUIRE(std::is_same_v<decltype(mean)::ElementType, double>);
+    REQUIRE(mean[0, 0] == 5.0); // (1 + 5 + 9) / 3
+
+    auto column_max = venus::eager::amax<0>(tensor, venus::eager::squeeze);
+    REQUIRE(column_max[2, 3] == 24);
+
+    auto row_min = venus::eager::amin<2>(tensor);
+    REQUIRE(row_min[1, 1, 0] == 17);
+
+    auto floats = Tensor<float, Device::CPU, 1>{-1.5f, -3.0f, -0.5f};
+    REQUIRE(venus::eager::amax(floats).value() == -0.5f);
+  }
+
+  SECTION("Any and all") {
+    auto mask = tensor > 20;
+    REQUIRE(venus::eager::any(mask));
+    REQUIRE_FALSE(venus::eager::all(mask));
+
+    auto per_row = venus::eager::any<2>(mask, venus::eager::squeeze);
+    STATIC_REQUIRE(std::is_same_v<decltype(per_row)::ElementType, bool>);
+    REQUIRE_FALSE(per_row[1, 1]);
+    REQUIRE(per_row[1, 2]);
+  }
+
+  SECTION("Count nonzero and fused predicates") {
+    auto mask = tensor > 20;
+    REQUIRE(venus::eager::count_nonzero(mask).value() == 4);
+    REQUIRE(venus::eager::count_nonzero<0>(tensor, venus::eager::squeeze)
+                .shape() == Shape<2>(3, 4));
+
+    REQUIRE(venus::eager::any_gt(tensor, 23));
+    REQUIRE_FALSE(venus::eager::any_gt(tensor, 24));
+    REQUIRE(venus::eager::all_gte(tensor, 1));
+    REQUIRE_FALSE(venus::eager::all_lt(tensor, 24));
+    REQUIRE(venus::eager::count_gt(tensor, 20) == 4);
+    REQUIRE(venus::eager::count_eq(venus::execution::par, tensor, 7) == 1);
+
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    auto floats = Tensor<float, Device::CPU, 1>{0.5f, nan, 2.0f};
+    REQUIRE_FALSE(venus::eager::all_gt(floats, 0.0f));
+    REQUIRE(venus::eager::count_neq(floats, 2.0f) == 2);
+
+    // Integers of mixed signedness compare by value
+    auto sizes = Tensor<unsigned, Device::CPU, 1>{0u, 3u, 4'000'000'000u};
+    REQUIRE(venus::eager::all_gt(sizes, -1));
+    REQUIRE_FALSE(venus::eager::any_lt(sizes, -1));
+    REQUIRE(venus::eager::count_neq(sizes, -1) == 3);
+    REQUIRE(venus::eager::count_gt(sizes, 3) == 1);
+    auto offsets = Tensor<int, Device::CPU, 1>{-2, 0, 5};
+    REQUIRE(venus::eager::count_lt(offsets, 1u) == 2);
+
+    // A hit in the last element of a long tensor is found on any policy
+    auto large = Tensor<float, Device::CPU, 1>(100'000);
+    large.fill(0);
+    REQUIRE(venus::eager::all(venus::execution::par,
+                              venus::eager::eq(large, 0.0f))
+                .value());
+    large[99'999] = 1.0f;
+    REQUIRE(venus::eager::any(venus::execution::par, large).value());
+    REQUIRE(venus::eager::any_gt(venus::execution::par, large, 0.5f));
+    REQUIRE(venus::eager::count_nonzero(venus::execution::par, large)
+                .value() == 1);
+  }
+
+  SECTION("Half precision accumulates in fp32") {
+    auto halves = Tensor<float16, Device::CPU, 2>(64, 3);
+    halves.fill(1);
+    halves[0, 0] = float16(2048);
+
+    auto columns = venus::eager::sum<0>(halves, venus::eager::squeeze);
+    STATIC_REQUIRE(std::is_same_v<decltype(columns)::ElementType, float16>);
+    // 2048 + 63 = 2111 in fp32, rounded once to binary16; summing in binary16
+    // would get stuck at 2048
+    REQUIRE(static_cast<float>(columns[0]) == 2112.0f);
+    REQUIRE(static_cast<float>(columns[1]) == 64.0f);
+  }
+
+  SECTION("Mean and variance") {
+    auto [mu, sigma2] = venus::eager::mean_var<2>(tensor);
+    STATIC_REQUIRE(std::is_same_v<decltype(mu)::ElementType, double>);
+    REQUIRE(mu.shape() == Shape<3>(2, 3, 1));
+    REQUIRE(mu[1, 2, 0] == 22.5);      // (21 + 22 + 23 + 24) / 4
+    REQUIRE(sigma2[1, 2, 0] == 1.25); // population variance of 4 consecutive
+    REQUIRE(venus::eager::equal(venus::eager::var<2>(tensor), sigma2));
+    REQUIRE(venus::eager::stddev(tensor).value() ==
+            std::sqrt(venus::eager::var(tensor).value()));
+
+    // Large offset, small spread: a naive sum of squares in float would
+    // cancel to nothing
+    auto shifted = Tensor<float, Device::CPU, 2>(2, 10'000);
+    for (std::size_t i = 0; i < shifted.size(); ++i) {
+      shifted.data()[i] = 1e4f + static_cast<float>(i % 2);
+    }
+    auto [row_mean, row_var] = venus::eager::mean_var<1>(
+        venus::execution::par, shifted, venus::eager::squeeze);
+    REQUIRE(std::abs(row_mean[0] - 10000.5f) < 1e-3f);
+    REQUIRE(std::abs(row_var[1] - 0.25f) < 1e-3f);
+
+    auto [column_mean, column_var] =
+        venus::eager::mean_var<0>(shifted, venus::eager::squeeze);
+    REQUIRE(column_mean[3] == 10001.0f);
+    REQUIRE(column_var[3] == 0.0f);
+  }
+
+  SECTION("Summation modes") {
+    // A column sum adds one row at a time onto its accumulator, so plain
+    // accumulation drifts over a block; pairwise and compensated sums do not
+    auto tenths = Tensor<float, Device::CPU, 2>(4096, 2);
+    tenths.fill(0.1f);
+    const auto exact = 4096 * static_cast<double>(0.1f);
+    auto relative_error = [&](const auto &summed) {
+      return std::abs(static_cast<double>(summed[0]) - exact) / exact;
+    };
+    REQUIRE(relative_error(venus::eager::sum<0>(
+                tenths, venus::eager::squeeze, venus::eager::pairwise)) <
+            1e-5);
+    REQUIRE(relative_error(venus::eager::sum<0>(
+                venus::execution::par, tenths, venus::eager::squeeze,
+                venus::eager::kahan)) < 1e-7);
+
+    auto cancelling = Tensor<float, Device::CPU, 1>{1e8f, 1.0f, -1e8f, 1.0f};
+    auto ones = Tensor<float, Device::CPU, 1>{1.0f, 1.0f, 1.0f, 1.0f};
+    REQUIRE(venus::eager::sum(cancelling, venus::eager::kahan).value() == 2.0f);
+    REQUIRE(cancelling.dot(ones, venus::eager::kahan).value() == 2.0f);
+    REQUIRE(venus::eager::mean(cancelling, venus::eager::kahan).value() ==
+            0.5f);
+
+    // Integer sums are exact in every mode
+    REQUIRE(venus::eager::sum(tensor, venus::eager::pairwise).value() == 300);
+    REQUIRE(venus::eager::sum(tensor, venus::eager::kahan).value() == 300);
+  }
+
+  SECTION("Parallel results match sequential bitwise") {
+    // Several reduction blocks, so par actually splits the work
+    auto values = Tensor<float, Device::CPU, 2>(3, 50'000);
+    auto weights = Tensor<float, Device::CPU, 2>(3, 50'000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      values.data()[i] = 1.0f / static_cast<float>(1 + (i % 977));
+    }
+    weights.fill(0.25f);
+
+    const auto seq_rows = venus::eager::sum<1>(venus::execution::seq, values);
+    const auto par_rows = venus::eager::sum<1>(venus::execution::par, values);
+    for (std::size_t i = 0; i < 3; ++i) {
+      REQUIRE(seq_rows[i, 0] == par_rows[i, 0]);
+    }
+
+    const auto seq_columns = venus::eager::sum<0>(values, venus::eager::squeeze);
+    const auto par_columns = venus::eager::sum<0>(
+        venus::execution::par_unseq, values, venus::eager::squeeze);
+    REQUIRE(venus::eager::equal(seq_columns, par_columns));
+
+    REQUIRE(venus::eager::sum(values).value() ==
+            venus::eager::sum(venus::execution::par, values).value());
+    REQUIRE(venus::eager::inner(values, weights).value() ==
+            venus::eager::inner(venus::execution::par, values, weights)
+                .value());
+    REQUIRE(venus::eager::equal(
+        venus::eager::einsum<"ij,ij->i">(values, weights),
+        venus::eager::einsum<"ij,ij->i">(venus::execution::par, values,
+                                         weights)));
+  }
+
+  SECTION("Empty extents in the kernel") {
+    // Eager tensors cannot be empty, raw pointers into the kernel can
+    using Max = venus::kernels::MaxReducer<float>;
+    using Mean = venus::kernels::MeanReducer<int>;
+    const float *no_floats = nullptr;
+    const int *no_ints = nullptr;
+
+    std::array<float, 3> maxima{1.0f, 2.0f, 3.0f};
+    venus::kernels::reduce<Max>(venus::execution::par, no_floats,
+                                std::array<std::size_t, 2>{3, 0},
+                                std::array<bool, 2>{false, true},
+                                maxima.data());
+    for (const auto value : maxima) {
+      REQUIRE(value == Max::finalize(Max::init(), 0));
+    }
+
+    std::array<double, 3> means{1.0, 2.0, 3.0};
+    venus::kernels::reduce<Mean>(venus::execution::seq, no_ints,
+                                 std::array<std::size_t, 2>{0, 3},
+                                 std::array<bool, 2>{true, false},
+                                 means.data());
+    // finalize(init(), 0) of a mean is 0 / 0
+    REQUIRE(std::isnan(Mean::finalize(Mean::init(), 0)));
+    for (const auto value : means) {
+      REQUIRE(std::isnan(value));
+    }
+
+    // No outputs: nothing is written
+    std::array<float, 1> untouched{5.0f};
+    venus::kernels::reduce<Max>(venus::execution::seq, no_floats,
+                                std::array<std::size_t, 2>{0, 4},
+                                std::array<bool, 2>{false, true},
+                                untouched.data());
+    REQUIRE(untouched[0] == 5.0f);
+  }
+}
+
+TEST_CASE("Index Reductions", "[tensor][ops][reduce]") {
+  const auto scores = Tensor<float, Device::CPU, 2>{{0.1f, 0.7f, 0.2f, 0.7f},
+                                                    {0.9f, -1.0f, 0.3f, 0.0f},
+                                                    {0.5f, 0.5f, 0.8f, 0.1f}};
+
+  SECTION("argmax and argmin") {
+    auto best = venus::eager::argmax<1>(scores);
+    STATIC_REQUIRE(std::is_same_v<decltype(best)::ElementType, std::size_t>);
+    REQUIRE(best.shape() == Shape<2>(3, 1));
+    REQUIRE(best[0, 0] == 1); // first of the tied maxima
+    REQUIRE(best[1, 0] == 0);
+    REQUIRE(best[2, 0] == 2);
+
+    auto worst = venus::eager::argmin<0>(scores, venus::eager::squeeze);
+    REQUIRE(worst.shape() == Shape<1>(4));
+    REQUIRE(worst[0] == 0);
+    REQUIRE(worst[1] == 1);
+    REQUIRE(worst[3] == 1);
+
+    REQUIRE(venus::eager::argmax(scores).value() == 4); // flat index
+    REQUIRE(venus::eager::argmin(scores).value() == 5);
+  }
+
+  SECTION("Values with indices") {
+    auto [values, indices] =
+        venus::eager::max_with_indices<1>(scores, venus::eager::squeeze);
+    REQUIRE(values[1] == 0.9f);
+    REQUIRE(values[2] == 0.8f);
+    REQUIRE(indices[2] == 2);
+  }
+
+  SECTION("Long rows match a serial scan") {
+    // Long enough for the lane scan, with the maximum in a lane tail and a
+    // tie in another lane
+    auto logits = Tensor<int, Device::CPU, 2>(3, 1000);
+    for (std::size_t i = 0; i < 3; ++i) {
+      for (std::size_t j = 0; j < 1000; ++j) {
+        logits[i, j] = static_cast<int>((j * 37 + i * 11) % 101);
+      }
+    }
+    logits[1, 997] = 500;
+    logits[2, 3] = 500;
+    logits[2, 700] = 500;
+
+    auto seq = venus::eager::argmax<1>(logits, venus::eager::squeeze);
+    auto par = venus::eager::argmax<1>(venus::execution::par, logits,
+                                       venus::eager::squeeze);
+    REQUIRE(venus::eager::equal(seq, par));
+    for (std::size_t i = 0; i < 3; ++i) {
+      std::size_t expected = 0;
+      for (std::size_t j = 1; j < 1000; ++j) {
+        if (logits[i, j] > logits[i, expected]) {
+          expected = j;
+        }
+      }
+      REQUIRE(seq[i] == expected);
+    }
+    REQUIRE(seq[2] == 3);
+  }
+
+  SECTION("NaN counts as the largest and smallest value") {
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    auto x = Tensor<float, Device::CPU, 1>{1.0f, nan, 3.0f};
+    REQUIRE(venus::eager::argmax(x).value() == 1);
+    REQUIRE(venus::eager::argmin(x).value() == 1);
+  }
+
+  SECTION("Top-k") {
+    auto [values, indices] = venus::eager::topk(scores, 2);
+    REQUIRE(values.shape() == Shape<2>(3, 2));
+    REQUIRE(values[0, 0] == 0.7f);
+    REQUIRE(indices[0, 0] == 1);
+    REQUIRE(indices[0, 1] == 3); // tie keeps position order
+    REQUIRE(values[1, 1] == 0.3f);
+    REQUIRE(indices[2, 1] == 0);
+
+    auto [column_values, column_indices] =
+        venus::eager::topk<0>(venus::execution::par, scores, 1);
+    REQUIRE(column_values.shape() == Shape<2>(1, 4));
+    REQUIRE(column_values[0, 2] == 0.8f);
+    REQUIRE(column_indices[0, 0] == 1);
+
+    REQUIRE_THROWS_AS(venus::eager::topk(scores, 5), std::invalid_argument);
+    REQUIRE_THROWS_AS(venus::eager::topk(scores, 0), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Softmax", "[tensor][ops][softmax]") {
+  const auto inf = std::numeric_limits<float>::infinity();
+
+  SECTION("Rows are distributions matching the definition") {
+    auto logits = Tensor<float, Device::CPU, 2>(4, 300);
+    for (std::size_t i = 0; i < 4; ++i) {
+      for (std::size_t j = 0; j < 300; ++j) {
+        logits[i, j] = static_cast<float>((j * 7 + i * 3) % 23) * 0.25f - 2.0f;
+      }
+    }
+
+    auto probs = venus::eager::softmax(logits);
+    REQUIRE(probs.shape() == logits.shape());
+    for (std::size_t i = 0; i < 4; ++i) {
+      double total = 0.0;
+      for (std::size_t j = 0; j < 300; ++j) {
+        total += std::exp(static_cast<double>(logits[i, j]));
+      }
+      double row_sum = 0.0;
+      for (std::size_t j = 0; j < 300; ++j) {
+        const auto expected = std::exp(static_cast<double>(logits[i, j])) / total;
+        REQUIRE(std::abs(probs[i, j] - expected) < 1e-5 * expected);
+        row_sum += probs[i, j];
+      }
+      REQUIRE(std::abs(row_sum - 1.0) < 1e-5);
+    }
+
+    auto par = venus::eager::softmax(venus::execution::par, logits);
+    REQUIRE(venus::eager::equal(probs, par));
+  }
+
+  SECTION("Along a strided axis") {
+    auto x = Tensor<float, Device::CPU, 2>{{1.0f, 2.0f}, {3.0f, 2.0f}};
+    auto columns = venus::eager::softmax<0>(x);
+    REQUIRE(std::abs(columns[0, 0] - 1.0f / (1.0f + std::exp(2.0f))) < 1e-6f);
+    REQUIRE(columns[0, 1] == 0.5f);
+    REQUIRE(columns[1, 1] == 0.5f);
+  }
+
+  SECTION("Large and masked inputs") {
+    auto x = Tensor<float, Device::CPU, 1>{1000.0f, 1001.0f, -inf};
+    auto probs = venus::eager::softmax(x);
+    REQUIRE(std::abs(probs[1] - 1.0f / (1.0f + std::exp(-1.0f))) < 1e-6f);
+    REQUIRE(probs[2] == 0.0f);
+
+    auto log_probs = venus::eager::log_softmax(x);
+    REQUIRE(std::abs(log_probs[0] - std::log(probs[0])) < 1e-5f);
+    REQUIRE(log_probs[2] == -inf);
+  }
+}
+
+TEST_CASE("Cumulative scans", "[tensor][ops][scan]") {
+  const auto x = Tensor<int, Device::CPU, 2>{{1, 2, 3}, {4, -5, 6}};
+
+  SECTION("Along either axis") {
+    auto rows = venus::eager::cumsum(x);
+    STATIC_REQUIRE(std::is_same_v<decltype(rows)::ElementType, int>);
+    REQUIRE(rows.shape() == x.shape());
+    REQUIRE(rows[0, 2] == 6);
+    REQUIRE(rows[1, 1] == -1);
+    REQUIRE(rows[1, 2] == 5);
+
+    auto columns = venus::eager::cumsum<0>(x);
+    REQUIRE(columns[0, 1] == 2);
+    REQUIRE(columns[1, 1] == -3);
+
+    auto products = venus::eager::cumprod(x);
+    REQUIRE(products[0, 2] == 6);
+    REQUIRE(products[1, 2] == -120);
+
+    auto running_max = venus::eager::cummax(x);
+    REQUIRE(running_max[1, 1] == 4);
+    REQUIRE(running_max[1, 2] == 6);
+    REQUIRE(venus::eager::cummin<0>(x)[1, 1] == -5);
+  }
+
+  SECTION("Long rows match a serial scan on any policy") {
+    // Several blocks per row, with a tail shorter than a register group
+    auto values = Tensor<double, Device::CPU, 2>(2, 10003);
+    for (std::size_t i = 0; i < 2; ++i) {
+      for (std::size_t j = 0; j < 10003; ++j) {
+        values[i, j] = static_cast<double>((j * 13 + i) % 7) - 3.0;
+      }
+    }
+
+    auto seq = venus::eager::cumsum(values);
+    auto par = venus::eager::cumsum(venus::execution::par, values);
+    REQUIRE(venus::eager::equal(seq, par));
+    for (std::size_t i = 0; i < 2; ++i) {
+      double running = 0.0;
+      for (std::size_t j = 0; j < 10003; ++j) {
+        running += values[i, j];
+        REQUIRE(seq[i, j] == running); // small integers sum exactly
+      }
+    }
+  }
+}
+
+TEST_CASE("Counting values", "[tensor][ops][unique]") {
+  const auto labels = Tensor<int, Device::CPU, 2>{{3, 1, 3}, {7, 1, 3}};
+
+  SECTION("Unique values, counts and inverse") {
+    auto values = venus::eager::unique(labels);
+    REQUIRE(values.shape() == Shape<1>(3));
+    REQUIRE(values[0] == 1);
+    REQUIRE(values[1] == 3);
+    REQUIRE(values[2] == 7);
+
+    auto [distinct, counts] = venus::eager::unique_counts(labels);
+    REQUIRE(counts[0] == 2);
+    REQUIRE(counts[1] == 3);
+    REQUIRE(counts[2] == 1);
+
+    auto [_, inverse] = venus::eager::unique_inverse(labels);
+    REQUIRE(inverse.shape() == labels.shape());
+    for (std::size_t i = 0; i < 2; ++i) {
+      for (std::size_t j = 0; j < 3; ++j) {
+        REQUIRE(values[inverse[i, j]] == labels[i, j]);
+      }
+    }
+
+    auto [all_values, first, all_inverse, all_counts] =
+        venus::eager::unique_all(labels);
+    REQUIRE(first[0] == 1); // flat index of the first 1
+    REQUIRE(first[2] == 3);
+  }
+
+  SECTION("Signed zeros and NaN") {
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    auto x = Tensor<float, Device::CPU, 1>{nan, 2.0f, -0.0f, 0.0f, nan, -1.0f};
+    auto [values, counts] = venus::eager::unique_counts(x);
+    REQUIRE(values.shape() == Shape<1>(4));
+    REQUIRE(values[0] == -1.0f);
+    REQUIRE(values[1] == 0.0f);
+    REQUIRE(counts[1] == 2);
+    REQUIRE(std::isnan(values[3]));
+    REQUIRE(counts[3] == 2);
+  }
+
+  SECTION("Many values match on any policy") {
+    // Mostly distinct values take the sorting path, repeated ones hashing
+    for (const std::size_t modulus : {100, 1'000'000}) {
+      auto ids = Tensor<long long, Device::CPU, 1>(200'000);
+      for (std::size_t i = 0; i < 200'000; ++i) {
+        ids[i] = static_cast<long long>((i * 7919) % modulus) - 50;
+      }
+      auto [seq, seq_counts] = venus::eager::unique_counts(ids);
+      auto [par, par_counts] =
+          venus::eager::unique_counts(venus::execution::par, ids);
+      REQUIRE(venus::eager::equal(seq, par));
+      REQUIRE(venus::eager::equal(seq_counts, par_counts));
+      REQUIRE(std::ranges::is_sorted(seq));
+      REQUIRE(seq.size() == std::min<std::size_t>(modulus, 200'000));
+    }
+  }
+
+  SECTION("Bincount") {
+    auto counts = venus::eager::bincount(labels);
+    REQUIRE(counts.shape() == Shape<1>(8));
+    REQUIRE(counts[1] == 2);
+    REQUIRE(counts[3] == 3);
+    REQUIRE(counts[5] == 0);
+    REQUIRE(venus::eager::bincount(venus::execution::par, labels, 10).size() ==
+            10);
+
+    auto negative = Tensor<int, Device::CPU, 1>{1, -2};
+    REQUIRE_THROWS_AS(venus::eager::bincount(negative), std::invalid_argument);
+  }
+
+  SECTION("Histogram") {
+    auto x = Tensor<float, Device::CPU, 1>{0.0f, 0.5f, 1.0f, 2.5f, 4.0f, 9.0f};
+    auto [counts, edges] = venus::eager::histogram(x, 4, 0.0, 4.0);
+    REQUIRE(edges.shape() == Shape<1>(5));
+    REQUIRE(edges[1] == 1.0f);
+    REQUIRE(counts[0] == 2);
+    REQUIRE(counts[1] == 1); // 1.0 sits on the edge of the second bin
+    REQUIRE(counts[2] == 1);
+    REQUIRE(counts[3] == 1); // the last bin includes 4.0; 9.0 is outside
+
+    auto [spanned, spanned_edges] =
+        venus::eager::histogram(venus::execution::par, x, 3);
+    REQUIRE(spanned_edges[3] == 9.0f);
+    REQUIRE(spanned[0] + spanned[1] + spanned[2] == 6);
+
+    REQUIRE_THROWS_AS(venus::eager::histogram(x, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(venus::eager::histogram(x, 2, 1.0, 0.0),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Segment reductions", "[tensor][ops][segment]") {
+  const auto values =
+      Tensor<float, Device::CPU, 2>{{1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f}};
+  const auto ids = Tensor<std::size_t, Device::CPU, 1>{2, 0, 2};
+
+  SECTION("Sum, mean and max over unsorted ids") {
+    auto sums = venus::eager::segment_sum(values, ids);
+    REQUIRE(sums.shape() == Shape<2>(3, 2));
+    REQUIRE(sums[0, 0] == 3.0f);
+    REQUIRE(sums[1, 1] == 0.0f); // no row maps to segment 1
+    REQUIRE(sums[2, 0] == 6.0f);
+    REQUIRE(sums[2, 1] == 8.0f);
+
+    auto means = venus::eager::segment_mean(values, ids);
+    REQUIRE(means[2, 0] == 3.0f);
+    REQUIRE(means[1, 0] == 0.0f);
+
+    auto maxima = venus::eager::segment_max(values, ids, 4);
+    REQUIRE(maxima.shape() == Shape<2>(4, 2));
+    REQUIRE(maxima[2, 1] == 6.0f);
+    REQUIRE(std::isinf(maxima[3, 0]));
+    REQUIRE(maxima[3, 0] < 0.0f);
+    const auto int_maxima = venus::eager::segment_max(
+        Tensor<int, Device::CPU, 2>{{1, 2}, {3, 4}, {5, 6}}, ids, 4);
+    REQUIRE(int_maxima[1, 0] == std::numeric_limits<int>::lowest());
+
+    REQUIRE_THROWS_AS(venus::eager::segment_sum(values, ids, 2),
+                      std::invalid_argument);
+    auto short_ids = Tensor<std::size_t, Device::CPU, 1>{0, 1};
+    REQUIRE_THROWS_AS(venus::eager::segment_sum(values, short_ids),
+                      std::invalid_argument);
+  }
+
+  SECTION("Scatter add along an axis") {
+    auto dst = Tensor<float, Device::CPU, 2>{{1.0f, 1.0f, 1.0f},
+                                             {1.0f, 1.0f, 1.0f}};
+    auto columns = Tensor<std::size_t, Device::CPU, 1>{2, 0, 2};
+    auto src = Tensor<float, Device::CPU, 2>{{1.0f, 3.0f, 5.0f},
+                                             {2.0f, 4.0f, 6.0f}};
+    auto result = venus::eager::scatter_add<1>(dst, columns, src);
+    REQUIRE(result[0, 0] == 4.0f);
+    REQUIRE(result[0, 1] == 1.0f);
+    REQUIRE(result[0, 2] == 7.0f); // repeated indices accumulate
+    REQUIRE(result[1, 2] == 9.0f);
+    REQUIRE(dst[0, 2] == 1.0f);
+
+    auto out_of_range = Tensor<std::size_t, Device::CPU, 1>{0, 3, 1};
+    REQUIRE_THROWS_AS(
+        venus::eager::scatter_add<1>(dst, out_of_range, src),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(venus::eager::scatter_add(dst, ids, values),
+                      std::invalid_argument);
+  }
+
+  SECTION("Many rows match on any policy") {
+    // Few segments use per-thread partials, many segments a grouping pass
+    auto x = Tensor<double, Device::CPU, 2>(100'000, 4);
+    auto row_ids = Tensor<std::size_t, Device::CPU, 1>(100'000);
+    for (const std::size_t segments : {7, 60'000}) {
+      for (std::size_t i = 0; i < 100'000; ++i) {
+        row_ids[i] = (i * 7919) % segments;
+        for (std::size_t j = 0; j < 4; ++j) {
+          x[i, j] = static_cast<double>((i + j) % 13) - 6.0;
+        }
+      }
+      auto seq = venus::eager::segment_sum(x, row_ids);
+      auto par = venus::eager::segment_sum(venus::execution::par, x, row_ids);
+      REQUIRE(seq.shape() == Shape<2>(segments, 4));
+      REQUIRE(venus::eager::equal(seq, par));
+      REQUIRE(venus::eager::equal(
+          venus::eager::segment_max(x, row_ids),
+          venus::eager::segment_max(venus::execution::par, x, row_ids)));
+    }
+  }
+}
+
 TEST_CASE("Einsum", "[tensor][ops][einsum]") {
 
   SECTION("Vector Inner (Dot) Product (i,i->)") {
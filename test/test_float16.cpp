@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <limits>
+#include <venus/float16.hpp>
+#include <venus/kernels/convert.hpp>
+
+using namespace venus;
+
+TEST_CASE("Half precision conversions", "[float16]") {
+  SECTION("Exactly representable values round trip") {
+    for (float value : {0.0f, -0.0f, 1.0f, -2.5f, 0.099975586f, 65504.0f}) {
+      REQUIRE(static_cast<float>(float16(value)) == value);
+    }
+    for (float value : {0.0f, 1.0f, -2.5f, 3.0e38f, 0.09960938f}) {
+      REQUIRE(static_cast<float>(bfloat16(value)) == value);
+    }
+  }
+
+  SECTION("Round to nearest even") {
+    // 2049 sits halfway between 2048 and 2050 in binary16
+    REQUIRE(static_cast<float>(float16(2049.0f)) == 2048.0f);
+    REQUIRE(static_cast<float>(float16(2051.0f)) == 2052.0f);
+    // 257 sits halfway between 256 and 258 in bfloat16
+    REQUIRE(static_cast<float>(bfloat16(257.0f)) == 256.0f);
+    REQUIRE(static_cast<float>(bfloat16(259.0f)) == 260.0f);
+  }
+
+  SECTION("Subnormals, overflow and NaN") {
+    REQUIRE(float16(std::ldexp(1.0f, -24)).bits() == 0x0001);
+    REQUIRE(float16(std::ldexp(1.0f, -25)).bits() == 0x0000);
+    REQUIRE(static_cast<float>(float16::fromBits(0x0001)) ==
+            std::ldexp(1.0f, -24));
+    REQUIRE(std::isinf(static_cast<float>(float16(65520.0f))));
+    REQUIRE(static_cast<float>(float16(65519.0f)) == 65504.0f);
+    REQUIRE(std::isnan(static_cast<float>(float16(std::nanf("")))));
+    REQUIRE(std::isnan(static_cast<float>(bfloat16(std::nanf("")))));
+  }
+
+  SECTION("Numeric limits") {
+    REQUIRE(static_cast<float>(std::numeric_limits<float16>::max()) ==
+            65504.0f);
+    REQUIRE(static_cast<float>(std::numeric_limits<float16>::epsilon()) ==
+            std::ldexp(1.0f, -10));
+    REQUIRE(static_cast<float>(std::numeric_limits<bfloat16>::epsilon()) ==
+            std::ldexp(1.0f, -7));
+  }
+}
+
+TEST_CASE("Half precision arithmetic", "[float16]") {
+  const auto a = float16(1.5f);
+  const auto b = float16(2);
+
+  STATIC_REQUIRE(std::is_same_v<decltype(a + b), float16>);
+  STATIC_REQUIRE(std::is_same_v<decltype(a * 2), float16>);
+  STATIC_REQUIRE(std::is_same_v<decltype(a * 2.0f), float>);
+  STATIC_REQUIRE(std::is_same_v<decltype(a + bfloat16(1)), float>);
+
+  REQUIRE(a + b == 3.5f);
+  REQUIRE(b / a > 1);
+  REQUIRE(a < b);
+  REQUIRE(-a == -1.5);
+
+  auto c = float16(0);
+  c += a;
+  c *= 2;
+  ++c;
+  REQUIRE(c == 4);
+}
+
+TEST_CASE("Half precision conversion kernels", "[float16][kernels]") {
+  constexpr std::size_t count = 37; // exercises both vector body and tail
+  float src[count];
+  float16 half[count];
+  bfloat16 brain[count];
+  float back[count];
+
+  for (std::size_t i = 0; i < count; ++i) {
+    src[i] = (static_cast<float>(i) - 18.0f) * 0.37f;
+  }
+
+  kernels::convert(src, half, count);
+  kernels::convert(half, back, count);
+  for (std::size_t i = 0; i < count; ++i) {
+    REQUIRE(half[i].bits() == float16(src[i]).bits());
+    REQUIRE(back[i] == static_cast<float>(half[i]));
+  }
+
+  kernels::convert(src, brain, count);
+  kernels::convert(brain, back, count);
+  for (std::size_t i = 0; i < count; ++i) {
+    REQUIRE(brain[i].bits() == bfloat16(src[i]).bits());
+    REQUIRE(back[i] == static_cast<float>(brain[i]));
+  }
+}
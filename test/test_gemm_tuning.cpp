@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <iterator>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <venus/kernels/cache_info.hpp>
+#include <venus/kernels/gemm.hpp>
+#include <venus/kernels/gemm_tuning.hpp>
+#include <venus/parallel/execution.hpp>
+#include <vector>
+
+using namespace venus;
+
+TEST_CASE("Cache sizes", "[gemm][tuning]") {
+  SECTION("Sysfs sizes and CPU lists") {
+    REQUIRE(kernels::detail::parse_cache_size("48K") == 48 << 10);
+    REQUIRE(kernels::detail::parse_cache_size("32M") == std::size_t{32} << 20);
+    REQUIRE(kernels::detail::parse_cache_size("512") == 512);
+    REQUIRE(kernels::detail::parse_cache_size("") == 0);
+
+    REQUIRE(kernels::detail::count_cpu_list("0") == 1);
+    REQUIRE(kernels::detail::count_cpu_list("0-3,8-11") == 8);
+    REQUIRE(kernels::detail::count_cpu_list("0,2,4-5") == 4);
+  }
+
+  SECTION("Detected sizes are usable") {
+    const auto &caches = kernels::cache_sizes();
+    REQUIRE(caches.l1d > 0);
+    REQUIRE(caches.l2 > 0);
+    REQUIRE(caches.l3 > 0);
+  }
+
+  SECTION("Default blocking follows the caches") {
+    constexpr auto mr = kernels::GemmTile<float>::mr;
+    constexpr auto nr = kernels::GemmTile<float>::nr;
+    const auto small = kernels::default_gemm_blocking<float>(
+        kernels::CacheSizes{32 << 10, 256 << 10, 2 << 20});
+    const auto large = kernels::default_gemm_blocking<float>(
+        kernels::CacheSizes{48 << 10, 2 << 20, 32 << 20});
+    for (const auto &blocking : {small, large}) {
+      REQUIRE(blocking.mc % mr == 0);
+      REQUIRE(blocking.nc % nr == 0);
+      REQUIRE(blocking.kc >= 64);
+      REQUIRE(blocking.kc <= 384);
+    }
+    REQUIRE(large.kc >= small.kc);
+    REQUIRE(large.mc > small.mc);
+    REQUIRE(large.nc > small.nc);
+  }
+}
+
+TEST_CASE("GEMM tuning cache", "[gemm][tuning]") {
+  const auto dir = std::filesystem::temp_directory_path() / "venus_gemm_tuning";
+  std::filesystem::remove_all(dir);
+  const auto path = dir / "nested" / "gemm_tuning.txt";
+
+  const auto key = kernels::gemm_tuning_key<float>(
+      kernels::CacheSizes{32 << 10, 256 << 10, 2 << 20});
+  const auto other = kernels::gemm_tuning_key<double>(
+      kernels::CacheSizes{32 << 10, 256 << 10, 2 << 20});
+  REQUIRE(key != other);
+
+  SECTION("Missing file or key") {
+    REQUIRE_FALSE(kernels::load_gemm_blocking(path, key).has_value());
+  }
+
+  SECTION("Entries round trip and are replaced") {
+    REQUIRE(kernels::store_gemm_blocking(path, key, {96, 256, 1024}));
+    REQUIRE(kernels::store_gemm_blocking(path, other, {48, 128, 512}));
+    REQUIRE(kernels::store_gemm_blocking(path, key, {144, 192, 2048}));
+
+    const auto stored = kernels::load_gemm_blocking(path, key);
+    REQUIRE(stored.has_value());
+    REQUIRE(stored->mc == 144);
+    REQUIRE(stored->kc == 192);
+    REQUIRE(stored->nc == 2048);
+    REQUIRE(kernels::load_gemm_blocking(path, other)->nc == 512);
+
+    std::ifstream file(path);
+    std::size_t lines = 0;
+    for (std::string line; std::getline(file, line);) {
+      ++lines;
+    }
+    REQUIRE(lines == 2);
+  }
+
+  SECTION("Concurrent stores leave a complete file") {
+    std::vector<std::string> keys;
+    for (std::size_t t = 0; t < 8; ++t) {
+      keys.push_back(kernels::gemm_tuning_key<float>(
+          kernels::CacheSizes{(t + 1) << 10, 256 << 10, 2 << 20}));
+    }
+    std::vector<std::thread> writers;
+    for (const auto &mine : keys) {
+      writers.emplace_back([&] {
+        for (std::size_t i = 0; i < 20; ++i) {
+          kernels::store_gemm_blocking(path, mine, {48, 128, 512 + i});
+        }
+      });
+    }
+    for (auto &writer : writers) {
+      writer.join();
+    }
+
+    // Entries may be lost to a concurrent writer, but the ones left are
+    // whole and no temporary file is left behind
+    std::size_t stored = 0;
+    for (const auto &key : keys) {
+      if (const auto entry = kernels::load_gemm_blocking(path, key)) {
+        REQUIRE(entry->mc == 48);
+        REQUIRE(entry->kc == 128);
+        ++stored;
+      }
+    }
+    std::ifstream file(path);
+    std::size_t lines = 0;
+    for (std::string line; std::getline(file, line);) {
+      ++lines;
+    }
+    REQUIRE(stored > 0);
+    REQUIRE(lines == stored);
+    REQUIRE(std::distance(
+                std::filesystem::directory_iterator(path.parent_path()),
+                std::filesystem::directory_iterator()) == 1);
+  }
+
+  SECTION("Malformed entries are ignored") {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path) << key << " 96 oops\n" << key << "0 1 2 3\n";
+    REQUIRE_FALSE(kernels::load_gemm_blocking(path, key).has_value());
+  }
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("GEMM tuning", "[gemm][tuning]") {
+  const auto problem = kernels::GemmTuningProblem{64, 96, 80};
+  const auto blocking = kernels::tune_gemm_blocking<float>(problem);
+  REQUIRE(blocking.mc > 0);
+  REQUIRE(blocking.kc > 0);
+  REQUIRE(blocking.nc > 0);
+
+  // Any blocking computes the same product
+  std::vector<float> a(problem.m * problem.k);
+  std::vector<float> b(problem.k * problem.n);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(i % 7) - 3.0f;
+  }
+  for (std::size_t i = 0; i < b.size(); ++i) {
+    b[i] = static_cast<float>(i % 5) - 2.0f;
+  }
+  std::vector<float> tuned(problem.m * problem.n);
+  std::vector<float> fallback(problem.m * problem.n);
+  kernels::gemm(execution::seq, problem.m, problem.n, problem.k,
+                kernels::MatrixView<float>{a.data(), problem.k, 1},
+                kernels::MatrixView<float>{b.data(), problem.n, 1},
+                tuned.data(), problem.n, blocking);
+  kernels::gemm(execution::seq, problem.m, problem.n, problem.k,
+                kernels::MatrixView<float>{a.data(), problem.k, 1},
+                kernels::MatrixView<float>{b.data(), problem.n, 1},
+                fallback.data(), problem.n);
+  REQUIRE(tuned == fallback);
+}